@@ -0,0 +1,14 @@
+local t = TalkAction("/luaprofiler")
+t.onSay = function(player, words, param)
+	if player:getAccountType() < ACCOUNT_TYPE_GOD then
+		return true
+	end
+
+	if Game.toggleLuaProfiler() then
+		player:sendColorMessage("Lua profiler started.", MESSAGE_COLOR_PURPLE)
+	else
+		player:sendColorMessage("Lua profiler stopped, profile written to data/logs/stats.", MESSAGE_COLOR_PURPLE)
+	end
+	return false
+end
+t:register()
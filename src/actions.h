@@ -122,7 +122,7 @@ class Actions final : public BaseEvents
 		Event_ptr getEvent(const std::string& nodeName) override;
 		bool registerEvent(Event_ptr event, const pugi::xml_node& node) override;
 
-		using ActionUseMap = std::map<uint16_t, Action>;
+		using ActionUseMap = std::unordered_map<uint16_t, Action>;
 		ActionUseMap useItemMap;
 		ActionUseMap uniqueItemMap;
 		ActionUseMap actionItemMap;
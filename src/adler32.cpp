@@ -0,0 +1,208 @@
+// Copyright 2022 The Forgotten Server Authors. All rights reserved.
+// Use of this source code is governed by the GPL-2.0 License that can be found in the LICENSE file.
+
+#include "otpch.h"
+
+#include "adler32.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ADLER32_X86
+#define ADLER32_TARGET(isa) __attribute__((target(isa)))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define ADLER32_X86
+#define ADLER32_TARGET(isa)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+namespace adler {
+
+namespace {
+
+constexpr uint32_t MOD = 65521;
+// largest n such that 255n(n+1)/2 + (n+1)(MOD-1) fits in 32 bits
+constexpr size_t NMAX = 5552;
+
+#ifdef ADLER32_X86
+constexpr size_t BLOCK_SIZE = 32;
+
+uint32_t finish(uint32_t a, uint32_t b, const uint8_t* data, size_t length)
+{
+	if (length != 0) {
+		return updateScalar((b << 16) | a, data, length);
+	}
+	return (b << 16) | a;
+}
+
+ADLER32_TARGET("ssse3")
+uint32_t hsum(__m128i v)
+{
+	v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+	v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+	return static_cast<uint32_t>(_mm_cvtsi128_si32(v));
+}
+
+ADLER32_TARGET("ssse3")
+uint32_t updateSSSE3(uint32_t adler, const uint8_t* data, size_t length)
+{
+	uint32_t a = adler & 0xFFFF;
+	uint32_t b = adler >> 16;
+
+	size_t blocks = length / BLOCK_SIZE;
+	length -= blocks * BLOCK_SIZE;
+
+	const __m128i tap1 = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17);
+	const __m128i tap2 = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i ones = _mm_set1_epi16(1);
+
+	while (blocks != 0) {
+		size_t n = std::min<size_t>(blocks, NMAX / BLOCK_SIZE);
+		blocks -= n;
+
+		//every byte of the chunk adds the incoming a to b once
+		__m128i prefix = _mm_set_epi32(0, 0, 0, a * n);
+		__m128i sumB = _mm_set_epi32(0, 0, 0, b);
+		__m128i sumA = zero;
+
+		do {
+			const __m128i bytes1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+			const __m128i bytes2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16));
+
+			prefix = _mm_add_epi32(prefix, sumA);
+
+			sumA = _mm_add_epi32(sumA, _mm_sad_epu8(bytes1, zero));
+			sumB = _mm_add_epi32(sumB, _mm_madd_epi16(_mm_maddubs_epi16(bytes1, tap1), ones));
+			sumA = _mm_add_epi32(sumA, _mm_sad_epu8(bytes2, zero));
+			sumB = _mm_add_epi32(sumB, _mm_madd_epi16(_mm_maddubs_epi16(bytes2, tap2), ones));
+
+			data += BLOCK_SIZE;
+		} while (--n);
+
+		sumB = _mm_add_epi32(sumB, _mm_slli_epi32(prefix, 5));
+
+		a = (a + hsum(sumA)) % MOD;
+		b = hsum(sumB) % MOD;
+	}
+
+	return finish(a, b, data, length);
+}
+
+ADLER32_TARGET("avx2")
+uint32_t updateAVX2(uint32_t adler, const uint8_t* data, size_t length)
+{
+	uint32_t a = adler & 0xFFFF;
+	uint32_t b = adler >> 16;
+
+	size_t blocks = length / BLOCK_SIZE;
+	length -= blocks * BLOCK_SIZE;
+
+	const __m256i tap = _mm256_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+	                                     16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1);
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i ones = _mm256_set1_epi16(1);
+
+	while (blocks != 0) {
+		size_t n = std::min<size_t>(blocks, NMAX / BLOCK_SIZE);
+		blocks -= n;
+
+		__m256i prefix = _mm256_setr_epi32(a * n, 0, 0, 0, 0, 0, 0, 0);
+		__m256i sumB = _mm256_setr_epi32(b, 0, 0, 0, 0, 0, 0, 0);
+		__m256i sumA = zero;
+
+		do {
+			const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+
+			prefix = _mm256_add_epi32(prefix, sumA);
+
+			sumA = _mm256_add_epi32(sumA, _mm256_sad_epu8(bytes, zero));
+			sumB = _mm256_add_epi32(sumB, _mm256_madd_epi16(_mm256_maddubs_epi16(bytes, tap), ones));
+
+			data += BLOCK_SIZE;
+		} while (--n);
+
+		sumB = _mm256_add_epi32(sumB, _mm256_slli_epi32(prefix, 5));
+
+		const __m128i lowA = _mm256_castsi256_si128(sumA), highA = _mm256_extracti128_si256(sumA, 1);
+		const __m128i lowB = _mm256_castsi256_si128(sumB), highB = _mm256_extracti128_si256(sumB, 1);
+		a = (a + hsum(_mm_add_epi32(lowA, highA))) % MOD;
+		b = hsum(_mm_add_epi32(lowB, highB)) % MOD;
+	}
+
+	return finish(a, b, data, length);
+}
+
+enum class Kernel { SCALAR, SSSE3, AVX2 };
+
+Kernel detectKernel()
+{
+#if defined(__GNUC__)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx2")) {
+		return Kernel::AVX2;
+	}
+	if (__builtin_cpu_supports("ssse3")) {
+		return Kernel::SSSE3;
+	}
+#else
+	int info[4];
+	__cpuid(info, 1);
+	const bool ssse3 = (info[2] & (1 << 9)) != 0;
+	//the os has to save the ymm registers too
+	const bool osxsave = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 6) == 6;
+	__cpuidex(info, 7, 0);
+	if (osxsave && (info[1] & (1 << 5)) != 0) {
+		return Kernel::AVX2;
+	}
+	if (ssse3) {
+		return Kernel::SSSE3;
+	}
+#endif
+	return Kernel::SCALAR;
+}
+#endif
+
+}
+
+uint32_t updateScalar(uint32_t adler, const uint8_t* data, size_t length)
+{
+	uint32_t a = adler & 0xFFFF;
+	uint32_t b = adler >> 16;
+
+	while (length > 0) {
+		size_t tmp = length > NMAX ? NMAX : length;
+		length -= tmp;
+
+		do {
+			a += *data++;
+			b += a;
+		} while (--tmp);
+
+		a %= MOD;
+		b %= MOD;
+	}
+
+	return (b << 16) | a;
+}
+
+uint32_t update(uint32_t adler, const uint8_t* data, size_t length)
+{
+#ifdef ADLER32_X86
+	static const Kernel kernel = detectKernel();
+	//short buffers (login checksums) are not worth the setup
+	if (length >= BLOCK_SIZE) {
+		switch (kernel) {
+			case Kernel::AVX2:
+				return updateAVX2(adler, data, length);
+			case Kernel::SSSE3:
+				return updateSSSE3(adler, data, length);
+			default:
+				break;
+		}
+	}
+#endif
+	return updateScalar(adler, data, length);
+}
+
+} // namespace adler
@@ -0,0 +1,24 @@
+// Copyright 2022 The Forgotten Server Authors. All rights reserved.
+// Use of this source code is governed by the GPL-2.0 License that can be found in the LICENSE file.
+
+#ifndef FS_ADLER32_H
+#define FS_ADLER32_H
+
+namespace adler {
+
+constexpr uint32_t INITIAL = 1;
+
+// continues a running checksum, so a buffer can be summed in pieces
+// picks an SSSE3 or AVX2 kernel at runtime when the cpu has one
+uint32_t update(uint32_t adler, const uint8_t* data, size_t length);
+
+inline uint32_t checksum(const uint8_t* data, size_t length) {
+	return update(INITIAL, data, length);
+}
+
+// byte-at-a-time reference the vector kernels must match
+uint32_t updateScalar(uint32_t adler, const uint8_t* data, size_t length);
+
+} // namespace adler
+
+#endif
@@ -149,6 +149,7 @@ bool Event::loadCallback()
 		console::reportWarning("[Event::loadCallback]", fmt::format("Event {:s} not found!", getScriptEventName()));
 		return false;
 	}
+	scriptInterface->setEventName(id, getScriptEventName());
 
 	scripted = true;
 	scriptId = id;
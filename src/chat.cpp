@@ -220,8 +220,7 @@ bool ChatChannel::executeCanJoinEvent(const Player& player)
 	lua_State* L = scriptInterface->getLuaState();
 
 	scriptInterface->pushFunction(canJoinEvent);
-	LuaScriptInterface::pushUserdata(L, &player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata(L, &player, LuaData_Player);
 
 	return scriptInterface->callFunction(1);
 }
@@ -245,8 +244,7 @@ bool ChatChannel::executeOnJoinEvent(const Player& player, bool isReload)
 	lua_State* L = scriptInterface->getLuaState();
 
 	scriptInterface->pushFunction(onJoinEvent);
-	LuaScriptInterface::pushUserdata(L, &player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata(L, &player, LuaData_Player);
 
 	lua_pushboolean(L, isReload);
 
@@ -272,8 +270,7 @@ bool ChatChannel::executeOnLeaveEvent(const Player& player)
 	lua_State* L = scriptInterface->getLuaState();
 
 	scriptInterface->pushFunction(onLeaveEvent);
-	LuaScriptInterface::pushUserdata(L, &player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata(L, &player, LuaData_Player);
 
 	return scriptInterface->callFunction(1);
 }
@@ -297,8 +294,7 @@ bool ChatChannel::executeOnSpeakEvent(const Player& player, MessageClasses& type
 	lua_State* L = scriptInterface->getLuaState();
 
 	scriptInterface->pushFunction(onSpeakEvent);
-	LuaScriptInterface::pushUserdata(L, &player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata(L, &player, LuaData_Player);
 
 	lua_pushnumber(L, type);
 	LuaScriptInterface::pushString(L, message);
@@ -189,6 +189,13 @@ class MagicField final : public Item
 	public:
 		explicit MagicField(uint16_t type) : Item(type), createTime(OTSYS_TIME()) {}
 
+		static void* operator new(size_t size) {
+			return ObjectPool::allocate(size, POOLED_MAGICFIELD);
+		}
+		static void operator delete(void* p, size_t size) {
+			ObjectPool::deallocate(p, size, POOLED_MAGICFIELD);
+		}
+
 		MagicField* getMagicField() override {
 			return this;
 		}
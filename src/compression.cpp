@@ -0,0 +1,124 @@
+// Copyright 2022 The Forgotten Server Authors. All rights reserved.
+// Use of this source code is governed by the GPL-2.0 License that can be found in the LICENSE file.
+
+#include "otpch.h"
+
+#include "compression.h"
+
+namespace {
+
+constexpr int WINDOW_BITS = -MAX_WBITS; // raw deflate, no zlib header or trailer
+constexpr std::array<uint8_t, 4> SYNC_FLUSH_TAIL {{0x00, 0x00, 0xFF, 0xFF}};
+
+std::atomic<uint64_t> compressedPackets {0};
+std::atomic<uint64_t> compressedInputBytes {0};
+std::atomic<uint64_t> compressedOutputBytes {0};
+std::atomic<uint64_t> compressionTime {0};
+
+}
+
+PacketDeflater::PacketDeflater(int level)
+{
+	initialized = deflateInit2(&stream, std::max(Z_NO_COMPRESSION, std::min(Z_BEST_COMPRESSION, level)), Z_DEFLATED, WINDOW_BITS, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+}
+
+PacketDeflater::~PacketDeflater()
+{
+	if (initialized) {
+		deflateEnd(&stream);
+	}
+}
+
+size_t PacketDeflater::getBound(size_t length) const
+{
+	//deflateBound does not account for the sync flush marker
+	return deflateBound(const_cast<z_stream*>(&stream), length) + SYNC_FLUSH_TAIL.size() + 6;
+}
+
+bool PacketDeflater::compress(const uint8_t* data, size_t length, uint8_t* output, size_t outputSize, size_t& outputLength)
+{
+	if (!initialized) {
+		return false;
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+
+	stream.next_in = const_cast<uint8_t*>(data);
+	stream.avail_in = length;
+	stream.next_out = output;
+	stream.avail_out = outputSize;
+
+	int ret = deflate(&stream, Z_SYNC_FLUSH);
+	if (ret != Z_OK || stream.avail_in != 0 || stream.avail_out == 0) {
+		//the stream can no longer be kept in sync with the client
+		deflateEnd(&stream);
+		initialized = false;
+		return false;
+	}
+
+	outputLength = outputSize - stream.avail_out;
+	if (outputLength >= SYNC_FLUSH_TAIL.size() && std::equal(SYNC_FLUSH_TAIL.begin(), SYNC_FLUSH_TAIL.end(), output + outputLength - SYNC_FLUSH_TAIL.size())) {
+		outputLength -= SYNC_FLUSH_TAIL.size();
+	}
+
+	compressedPackets.fetch_add(1, std::memory_order_relaxed);
+	compressedInputBytes.fetch_add(length, std::memory_order_relaxed);
+	compressedOutputBytes.fetch_add(outputLength, std::memory_order_relaxed);
+	compressionTime.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(), std::memory_order_relaxed);
+	return true;
+}
+
+PacketDeflater::Stats PacketDeflater::getStats()
+{
+	return {
+		compressedPackets.load(std::memory_order_relaxed),
+		compressedInputBytes.load(std::memory_order_relaxed),
+		compressedOutputBytes.load(std::memory_order_relaxed),
+		compressionTime.load(std::memory_order_relaxed)
+	};
+}
+
+PacketInflater::PacketInflater()
+{
+	initialized = inflateInit2(&stream, WINDOW_BITS) == Z_OK;
+}
+
+PacketInflater::~PacketInflater()
+{
+	if (initialized) {
+		inflateEnd(&stream);
+	}
+}
+
+bool PacketInflater::decompress(const uint8_t* data, size_t length, std::vector<uint8_t>& output)
+{
+	if (!initialized) {
+		return false;
+	}
+
+	std::vector<uint8_t> input;
+	input.reserve(length + SYNC_FLUSH_TAIL.size());
+	input.insert(input.end(), data, data + length);
+	input.insert(input.end(), SYNC_FLUSH_TAIL.begin(), SYNC_FLUSH_TAIL.end());
+
+	stream.next_in = input.data();
+	stream.avail_in = input.size();
+
+	output.clear();
+	std::array<uint8_t, 16384> chunk;
+	do {
+		stream.next_out = chunk.data();
+		stream.avail_out = chunk.size();
+
+		int ret = inflate(&stream, Z_SYNC_FLUSH);
+		if (ret != Z_OK && ret != Z_BUF_ERROR) {
+			return false;
+		}
+
+		output.insert(output.end(), chunk.data(), chunk.data() + (chunk.size() - stream.avail_out));
+		if (ret == Z_BUF_ERROR) {
+			break;
+		}
+	} while (stream.avail_in != 0 || stream.avail_out == 0);
+	return true;
+}
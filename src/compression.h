@@ -0,0 +1,71 @@
+// Copyright 2022 The Forgotten Server Authors. All rights reserved.
+// Use of this source code is governed by the GPL-2.0 License that can be found in the LICENSE file.
+
+#ifndef FS_COMPRESSION_H
+#define FS_COMPRESSION_H
+
+#include <zlib.h>
+
+/*
+ * raw deflate streams used for game packets, one stream lives as long as
+ * the connection so later packets can reference data sent earlier; every
+ * packet ends with a sync flush whose empty stored block (00 00 ff ff) is
+ * not sent, the inflater adds it back before decoding
+ */
+class PacketDeflater
+{
+	public:
+		struct Stats {
+			uint64_t packets;
+			uint64_t inputBytes;
+			uint64_t outputBytes;
+			uint64_t time; // nanoseconds
+		};
+
+		explicit PacketDeflater(int level);
+		~PacketDeflater();
+
+		// non-copyable
+		PacketDeflater(const PacketDeflater&) = delete;
+		PacketDeflater& operator=(const PacketDeflater&) = delete;
+
+		bool isInitialized() const {
+			return initialized;
+		}
+
+		// worst case size of the compressed form of a packet
+		size_t getBound(size_t length) const;
+
+		// once this returns true the packet is part of the stream and must be sent compressed
+		bool compress(const uint8_t* data, size_t length, uint8_t* output, size_t outputSize, size_t& outputLength);
+
+		static Stats getStats();
+
+	private:
+		z_stream stream {};
+		bool initialized = false;
+};
+
+// decoding side, for test clients and tools reading recorded traffic
+class PacketInflater
+{
+	public:
+		PacketInflater();
+		~PacketInflater();
+
+		// non-copyable
+		PacketInflater(const PacketInflater&) = delete;
+		PacketInflater& operator=(const PacketInflater&) = delete;
+
+		bool isInitialized() const {
+			return initialized;
+		}
+
+		bool decompress(const uint8_t* data, size_t length, std::vector<uint8_t>& output);
+
+	private:
+		z_stream stream {};
+		bool initialized = false;
+};
+
+#endif
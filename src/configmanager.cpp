@@ -103,6 +103,31 @@ ExperienceStages loadLuaStages(lua_State* L)
 	return stages;
 }
 
+InputBudgets loadLuaInputBudgets(lua_State* L)
+{
+	InputBudgets budgets = {};
+
+	lua_getglobal(L, "inputBudgets");
+	if (!lua_istable(L, -1)) {
+		lua_pop(L, 1);
+		return budgets;
+	}
+
+	lua_pushnil(L);
+	while (lua_next(L, -2) != 0) {
+		if (lua_isnumber(L, -2) && lua_isnumber(L, -1)) {
+			auto opcode = lua_tonumber(L, -2);
+			auto budget = lua_tonumber(L, -1);
+			if (opcode >= 0 && opcode < budgets.size() && budget >= 0) {
+				budgets[static_cast<size_t>(opcode)] = static_cast<uint16_t>(std::min<lua_Number>(budget, std::numeric_limits<uint16_t>::max()));
+			}
+		}
+		lua_pop(L, 1);
+	}
+	lua_pop(L, 1);
+	return budgets;
+}
+
 ExperienceStages loadXMLStages()
 {
 	pugi::xml_document doc;
@@ -183,6 +208,9 @@ bool ConfigManager::load(bool isReload)
 		string[MYSQL_SOCK] = getGlobalString(L, "mysqlSock", "");
 
 		integer[SQL_PORT] = getGlobalNumber(L, "mysqlPort", 3306);
+		integer[DATABASE_WORKERS] = getGlobalNumber(L, "databaseWorkers", 4);
+		integer[PLAYER_NAME_CACHE_SIZE] = getGlobalNumber(L, "playerNameCacheSize", 8192);
+		boolean[PLAYER_NAME_CACHE_PRELOAD] = getGlobalBoolean(L, "playerNameCachePreload", false);
 
 		if (integer[GAME_PORT] == 0) {
 			integer[GAME_PORT] = getGlobalNumber(L, "gameProtocolPort", 7172);
@@ -193,6 +221,7 @@ bool ConfigManager::load(bool isReload)
 		}
 
 		integer[STATUS_PORT] = getGlobalNumber(L, "statusProtocolPort", 7171);
+		integer[METRICS_PORT] = getGlobalNumber(L, "metricsPort", 0);
 
 		integer[MARKET_OFFER_DURATION] = getGlobalNumber(L, "marketOfferDuration", 30 * 24 * 60 * 60);
 	}
@@ -221,6 +250,7 @@ bool ConfigManager::load(bool isReload)
 	boolean[SERVER_SAVE_CLEAN_MAP] = getGlobalBoolean(L, "serverSaveCleanMap", false);
 	boolean[SERVER_SAVE_CLOSE] = getGlobalBoolean(L, "serverSaveClose", false);
 	boolean[SERVER_SAVE_SHUTDOWN] = getGlobalBoolean(L, "serverSaveShutdown", true);
+	boolean[SERVER_SAVE_IN_BACKGROUND] = getGlobalBoolean(L, "serverSaveInBackground", false);
 	boolean[ONLINE_OFFLINE_CHARLIST] = getGlobalBoolean(L, "showOnlineStatusInCharlist", false);
 	boolean[YELL_ALLOW_PREMIUM] = getGlobalBoolean(L, "yellAlwaysAllowPremium", false);
 	boolean[PREMIUM_TO_SEND_PRIVATE] = getGlobalBoolean(L, "premiumToSendPrivate", false);
@@ -239,6 +269,9 @@ bool ConfigManager::load(bool isReload)
 	boolean[UNLOCK_ALL_MOUNTS] = getGlobalBoolean(L, "unlockAllMounts", false);
 	boolean[UNLOCK_ALL_FAMILIARS] = getGlobalBoolean(L, "unlockAllFamiliars", false);
 	boolean[ALLOW_SPAWN_BLOCKING] = getGlobalBoolean(L, "allowSpawnBlocking", false);
+	boolean[LUA_BYTECODE_CACHE] = getGlobalBoolean(L, "luaBytecodeCache", true);
+	boolean[PACKET_COMPRESSION] = getGlobalBoolean(L, "packetCompression", false);
+	boolean[INPUT_QUEUE] = getGlobalBoolean(L, "inputQueue", true);
 
 	string[DEFAULT_PRIORITY] = getGlobalString(L, "defaultPriority", "high");
 	string[SERVER_NAME] = getGlobalString(L, "serverName", "");
@@ -277,6 +310,8 @@ bool ConfigManager::load(bool isReload)
 	integer[CHECK_EXPIRED_MARKET_OFFERS_EACH_MINUTES] = getGlobalNumber(L, "checkExpiredMarketOffersEachMinutes", 60);
 	integer[MAX_MARKET_OFFERS_AT_A_TIME_PER_PLAYER] = getGlobalNumber(L, "maxMarketOffersAtATimePerPlayer", 100);
 	integer[MAX_PACKETS_PER_SECOND] = getGlobalNumber(L, "maxPacketsPerSecond", 25);
+	integer[PACKET_COMPRESSION_LEVEL] = getGlobalNumber(L, "packetCompressionLevel", 6);
+	integer[INPUT_QUEUE_SIZE] = getGlobalNumber(L, "inputQueueSize", 64);
 	integer[SERVER_SAVE_NOTIFY_DURATION] = getGlobalNumber(L, "serverSaveNotifyDuration", 5);
 	integer[YELL_MINIMUM_LEVEL] = getGlobalNumber(L, "yellMinimumLevel", 2);
 	integer[MINIMUM_LEVEL_TO_SEND_PRIVATE] = getGlobalNumber(L, "minimumLevelToSendPrivate", 1);
@@ -310,6 +345,11 @@ bool ConfigManager::load(bool isReload)
 	}
 	expStages.shrink_to_fit();
 
+	const InputBudgets budgets = loadLuaInputBudgets(L);
+	for (size_t opcode = 0; opcode < budgets.size(); ++opcode) {
+		inputBudgets[opcode].store(budgets[opcode], std::memory_order_relaxed);
+	}
+
 	loaded = true;
 	lua_close(L);
 
@@ -5,6 +5,7 @@
 #define FS_CONFIGMANAGER_H
 
 using ExperienceStages = std::vector<std::tuple<uint32_t, uint32_t, float>>;
+using InputBudgets = std::array<uint16_t, 256>;
 
 class ConfigManager
 {
@@ -38,6 +39,7 @@ class ConfigManager
 			SERVER_SAVE_CLEAN_MAP,
 			SERVER_SAVE_CLOSE,
 			SERVER_SAVE_SHUTDOWN,
+			SERVER_SAVE_IN_BACKGROUND,
 			ONLINE_OFFLINE_CHARLIST,
 			YELL_ALLOW_PREMIUM,
 			PREMIUM_TO_SEND_PRIVATE,
@@ -56,6 +58,10 @@ class ConfigManager
 			UNLOCK_ALL_MOUNTS,
 			UNLOCK_ALL_FAMILIARS,
 			ALLOW_SPAWN_BLOCKING,
+			LUA_BYTECODE_CACHE,
+			PACKET_COMPRESSION,
+			INPUT_QUEUE,
+			PLAYER_NAME_CACHE_PRELOAD,
 
 			LAST_BOOLEAN_CONFIG /* this must be the last one */
 		};
@@ -111,6 +117,7 @@ class ConfigManager
 			GAME_PORT,
 			LOGIN_PORT,
 			STATUS_PORT,
+			METRICS_PORT,
 			STAIRHOP_DELAY,
 			MARKET_OFFER_DURATION,
 			CHECK_EXPIRED_MARKET_OFFERS_EACH_MINUTES,
@@ -130,6 +137,10 @@ class ConfigManager
 			MAX_MARKET_FEE,
 			MAX_QUICK_LOOT_LIST_SIZE,
 			REWARD_BAG_DURATION,
+			PACKET_COMPRESSION_LEVEL,
+			INPUT_QUEUE_SIZE,
+			DATABASE_WORKERS,
+			PLAYER_NAME_CACHE_SIZE,
 
 			LAST_INTEGER_CONFIG /* this must be the last one */
 		};
@@ -142,6 +153,11 @@ class ConfigManager
 		bool getBoolean(boolean_config_t what) const;
 		float getExperienceStage(uint32_t level) const;
 		ExperienceStages getExperienceStages() const;
+		// pending actions a player may have queued per client opcode, 0 means no limit
+		uint16_t getInputBudget(uint8_t opcode) const {
+			//read by network threads while a reload may store new budgets
+			return inputBudgets[opcode].load(std::memory_order_relaxed);
+		}
 		bool setString(string_config_t what, const std::string& value);
 		bool setNumber(integer_config_t what, int32_t value);
 		bool setBoolean(boolean_config_t what, bool value);
@@ -152,6 +168,7 @@ class ConfigManager
 		bool boolean[LAST_BOOLEAN_CONFIG] = {};
 
 		ExperienceStages expStages = {};
+		std::array<std::atomic<uint16_t>, 256> inputBudgets = {};
 
 		bool loaded = false;
 };
@@ -13,35 +13,73 @@
 
 extern ConfigManager g_config;
 
-Connection_ptr ConnectionManager::createConnection(boost::asio::io_service& io_service, ConstServicePort_ptr servicePort)
+std::unique_lock<std::mutex> ConnectionManager::lockShard(Shard& shard)
 {
-	std::lock_guard<std::mutex> lockClass(connectionManagerLock);
+	std::unique_lock<std::mutex> lock(shard.lock, std::try_to_lock);
+	if (!lock.owns_lock()) {
+		const auto start = std::chrono::steady_clock::now();
+		lock.lock();
+		const auto waitTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+		lockContentions.fetch_add(1, std::memory_order_relaxed);
+		lockWaitTime.fetch_add(waitTime.count(), std::memory_order_relaxed);
+		contendedLockWait.observe(waitTime);
+	}
+	return lock;
+}
 
-	auto connection = std::make_shared<Connection>(io_service, servicePort);
-	connections.insert(connection);
+Connection_ptr ConnectionManager::createConnection(boost::asio::io_service& io_service, ConstServicePort_ptr servicePort)
+{
+	const uint64_t connectionId = nextConnectionId.fetch_add(1, std::memory_order_relaxed);
+	auto connection = std::make_shared<Connection>(io_service, servicePort, connectionId);
+
+	Shard& shard = getShard(connectionId);
+	auto lock = lockShard(shard);
+	shard.connections.insert(connection);
+	created.fetch_add(1, std::memory_order_relaxed);
+	activeConnections.add(1);
+	acceptedConnections.increment();
 	return connection;
 }
 
 void ConnectionManager::releaseConnection(const Connection_ptr& connection)
 {
-	std::lock_guard<std::mutex> lockClass(connectionManagerLock);
-
-	connections.erase(connection);
+	Shard& shard = getShard(connection->id);
+	auto lock = lockShard(shard);
+	if (shard.connections.erase(connection) != 0) {
+		released.fetch_add(1, std::memory_order_relaxed);
+		activeConnections.add(-1);
+	}
 }
 
 void ConnectionManager::closeAll()
 {
-	std::lock_guard<std::mutex> lockClass(connectionManagerLock);
-
-	for (const auto& connection : connections) {
-		try {
-			boost::system::error_code error;
-			connection->socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, error);
-			connection->socket.close(error);
-		} catch (boost::system::system_error&) {
+	for (Shard& shard : shards) {
+		auto lock = lockShard(shard);
+		for (const auto& connection : shard.connections) {
+			connection->strand.post([connection]() {
+				try {
+					boost::system::error_code error;
+					connection->socket.shutdown(boost::asio::ip::tcp::socket::shutdown_both, error);
+					connection->socket.close(error);
+				} catch (boost::system::system_error&) {
+				}
+			});
 		}
+		released.fetch_add(shard.connections.size(), std::memory_order_relaxed);
+		activeConnections.add(-static_cast<int64_t>(shard.connections.size()));
+		shard.connections.clear();
 	}
-	connections.clear();
+}
+
+ConnectionManager::Stats ConnectionManager::getStats() const
+{
+	Stats stats;
+	stats.created = created.load(std::memory_order_relaxed);
+	stats.released = released.load(std::memory_order_relaxed);
+	stats.active = stats.created >= stats.released ? stats.created - stats.released : 0;
+	stats.lockContentions = lockContentions.load(std::memory_order_relaxed);
+	stats.lockWaitTime = lockWaitTime.load(std::memory_order_relaxed);
+	return stats;
 }
 
 // Connection
@@ -51,7 +89,11 @@ void Connection::close(bool force)
 	//any thread
 	ConnectionManager::getInstance().releaseConnection(shared_from_this());
 
-	std::lock_guard<std::recursive_mutex> lockClass(connectionLock);
+	strand.dispatch([thisPtr = shared_from_this(), force]() { thisPtr->internalClose(force); });
+}
+
+void Connection::internalClose(bool force)
+{
 	connectionState = CONNECTION_STATE_DISCONNECTED;
 #ifdef DEBUG_DISCONNECT
 	console::print(CONSOLEMESSAGE_TYPE_INFO, "[DEBUG] connection state: Disconnected");
@@ -97,18 +139,35 @@ Connection::~Connection()
 	closeSocket();
 }
 
+void Connection::readRemoteIP()
+{
+	// IP-address is expressed in network byte order
+	boost::system::error_code error;
+	const boost::asio::ip::tcp::endpoint endpoint = socket.remote_endpoint(error);
+	if (!error) {
+		remoteIP = htonl(endpoint.address().to_v4().to_ulong());
+	}
+}
+
 void Connection::accept(Protocol_ptr protocol)
 {
-	this->protocol = protocol;
-	g_dispatcher.addTask(createTask(([=]() { protocol->onConnect(); })));
-	connectionState = CONNECTION_STATE_GAMEWORLD_AUTH;
+	strand.dispatch([thisPtr = shared_from_this(), protocol]() {
+		thisPtr->protocol = protocol;
+		g_dispatcher.addTask(createTask(([=]() { protocol->onConnect(); })));
+		thisPtr->connectionState = CONNECTION_STATE_GAMEWORLD_AUTH;
 #ifdef DEBUG_DISCONNECT
-	console::print(CONSOLEMESSAGE_TYPE_INFO, "[DEBUG] connection state: gameworld auth");
+		console::print(CONSOLEMESSAGE_TYPE_INFO, "[DEBUG] connection state: gameworld auth");
 #endif
-	accept();
+		thisPtr->internalAccept();
+	});
 }
 
 void Connection::accept()
+{
+	strand.dispatch([thisPtr = shared_from_this()]() { thisPtr->internalAccept(); });
+}
+
+void Connection::internalAccept()
 {
 	if (connectionState == CONNECTION_STATE_PENDING) {
 		connectionState = CONNECTION_STATE_REQUEST_CHARLIST;
@@ -117,7 +176,6 @@ void Connection::accept()
 #endif
 	}
 
-	std::lock_guard<std::recursive_mutex> lockClass(connectionLock);
 	try {
 		readTimer.expires_from_now(std::chrono::seconds(CONNECTION_READ_TIMEOUT));
 		readTimer.async_wait([thisPtr = std::weak_ptr<Connection>(shared_from_this())](const boost::system::error_code& error) { Connection::handleTimeout(thisPtr, error); });
@@ -126,7 +184,7 @@ void Connection::accept()
 		auto bufferLength = !receivedLastChar && receivedName && connectionState == CONNECTION_STATE_GAMEWORLD_AUTH ? 1 : NetworkMessage::HEADER_LENGTH;
 		boost::asio::async_read(socket,
 								boost::asio::buffer(msg.getBuffer(), bufferLength),
-								[thisPtr = shared_from_this()](const boost::system::error_code& error, auto /*bytes_transferred*/) { thisPtr->parseHeader(error); });
+								boost::asio::bind_executor(strand, [thisPtr = shared_from_this()](const boost::system::error_code& error, auto /*bytes_transferred*/) { thisPtr->parseHeader(error); }));
 	} catch (boost::system::system_error& e) {
 		console::reportError("Connection::accept", fmt::format("Network error: {:s}", e.what()));
 		close(FORCE_CLOSE);
@@ -135,7 +193,6 @@ void Connection::accept()
 
 void Connection::parseHeader(const boost::system::error_code& error)
 {
-	std::lock_guard<std::recursive_mutex> lockClass(connectionLock);
 	readTimer.cancel();
 
 	if (error) {
@@ -170,7 +227,7 @@ void Connection::parseHeader(const boost::system::error_code& error)
 #ifdef DEBUG_DISCONNECT
 				console::print(CONSOLEMESSAGE_TYPE_INFO, "[DEBUG] Reading world name (code 38)");
 #endif
-				accept();
+				internalAccept();
 				return;
 			}
 
@@ -185,7 +242,7 @@ void Connection::parseHeader(const boost::system::error_code& error)
 			}
 #endif
 
-			accept();
+			internalAccept();
 			return;
 		}
 	}
@@ -218,7 +275,7 @@ void Connection::parseHeader(const boost::system::error_code& error)
 		// Read packet content
 		msg.setLength(size + NetworkMessage::HEADER_LENGTH);
 		boost::asio::async_read(socket, boost::asio::buffer(msg.getBodyBuffer(), size),
-								[thisPtr = shared_from_this()](const boost::system::error_code& error, auto /*bytes_transferred*/) { thisPtr->parsePacket(error); });
+								boost::asio::bind_executor(strand, [thisPtr = shared_from_this()](const boost::system::error_code& error, auto /*bytes_transferred*/) { thisPtr->parsePacket(error); }));
 	} catch (boost::system::system_error& e) {
 		console::reportError("Connection::parseHeader", fmt::format("Network error: {:s}", e.what()));
 		close(FORCE_CLOSE);
@@ -227,7 +284,6 @@ void Connection::parseHeader(const boost::system::error_code& error)
 
 void Connection::parsePacket(const boost::system::error_code& error)
 {
-	std::lock_guard<std::recursive_mutex> lockClass(connectionLock);
 	readTimer.cancel();
 
 	if (error) {
@@ -281,7 +337,7 @@ void Connection::parsePacket(const boost::system::error_code& error)
 		// Wait to the next packet
 		boost::asio::async_read(socket,
 								boost::asio::buffer(msg.getBuffer(), NetworkMessage::HEADER_LENGTH),
-								[thisPtr = shared_from_this()](const boost::system::error_code& error, auto /*bytes_transferred*/) { thisPtr->parseHeader(error); });
+								boost::asio::bind_executor(strand, [thisPtr = shared_from_this()](const boost::system::error_code& error, auto /*bytes_transferred*/) { thisPtr->parseHeader(error); }));
 	} catch (boost::system::system_error& e) {
 		console::reportError("Connection::parsePacket", fmt::format("Network error: {:s}", e.what()));
 		close(FORCE_CLOSE);
@@ -290,16 +346,17 @@ void Connection::parsePacket(const boost::system::error_code& error)
 
 void Connection::send(const OutputMessage_ptr& msg)
 {
-	std::lock_guard<std::recursive_mutex> lockClass(connectionLock);
-	if (connectionState == CONNECTION_STATE_DISCONNECTED) {
-		return;
-	}
+	strand.dispatch([thisPtr = shared_from_this(), msg]() {
+		if (thisPtr->connectionState == CONNECTION_STATE_DISCONNECTED) {
+			return;
+		}
 
-	bool noPendingWrite = messageQueue.empty();
-	messageQueue.emplace_back(msg);
-	if (noPendingWrite) {
-		internalSend(msg);
-	}
+		bool noPendingWrite = thisPtr->messageQueue.empty();
+		thisPtr->messageQueue.emplace_back(msg);
+		if (noPendingWrite) {
+			thisPtr->internalSend(msg);
+		}
+	});
 }
 
 void Connection::internalSend(const OutputMessage_ptr& msg)
@@ -311,30 +368,15 @@ void Connection::internalSend(const OutputMessage_ptr& msg)
 
 		boost::asio::async_write(socket,
 								boost::asio::buffer(msg->getOutputBuffer(), msg->getLength()),
-								[thisPtr = shared_from_this()](const boost::system::error_code& error, auto /*bytes_transferred*/) { thisPtr->onWriteOperation(error); });
+								boost::asio::bind_executor(strand, [thisPtr = shared_from_this()](const boost::system::error_code& error, auto /*bytes_transferred*/) { thisPtr->onWriteOperation(error); }));
 	} catch (boost::system::system_error& e) {
 		console::reportError("Connection::internalSend", fmt::format("Network error: {:s}", e.what()));
 		close(FORCE_CLOSE);
 	}
 }
 
-uint32_t Connection::getIP()
-{
-	std::lock_guard<std::recursive_mutex> lockClass(connectionLock);
-
-	// IP-address is expressed in network byte order
-	boost::system::error_code error;
-	const boost::asio::ip::tcp::endpoint endpoint = socket.remote_endpoint(error);
-	if (error) {
-		return 0;
-	}
-
-	return htonl(endpoint.address().to_v4().to_ulong());
-}
-
 void Connection::onWriteOperation(const boost::system::error_code& error)
 {
-	std::lock_guard<std::recursive_mutex> lockClass(connectionLock);
 	writeTimer.cancel();
 	messageQueue.pop_front();
 
@@ -4,6 +4,7 @@
 #ifndef FS_CONNECTION_H
 #define FS_CONNECTION_H
 
+#include "metrics.h"
 #include "networkmessage.h"
 
 enum ConnectionState_t {
@@ -39,6 +40,16 @@ using ConstServicePort_ptr = std::shared_ptr<const ServicePort>;
 class ConnectionManager
 {
 	public:
+		static constexpr size_t SHARD_COUNT = 16;
+
+		struct Stats {
+			uint64_t active;
+			uint64_t created;
+			uint64_t released;
+			uint64_t lockContentions;
+			uint64_t lockWaitTime; // nanoseconds
+		};
+
 		static ConnectionManager& getInstance() {
 			static ConnectionManager instance;
 			return instance;
@@ -48,11 +59,33 @@ class ConnectionManager
 		void releaseConnection(const Connection_ptr& connection);
 		void closeAll();
 
+		Stats getStats() const;
+
 	private:
 		ConnectionManager() = default;
 
-		std::unordered_set<Connection_ptr> connections;
-		std::mutex connectionManagerLock;
+		struct Shard {
+			std::unordered_set<Connection_ptr> connections;
+			std::mutex lock;
+		};
+
+		//connections are spread by id so accepting and closing rarely contend on the same lock
+		Shard& getShard(uint64_t connectionId) {
+			return shards[connectionId % SHARD_COUNT];
+		}
+		std::unique_lock<std::mutex> lockShard(Shard& shard);
+
+		std::array<Shard, SHARD_COUNT> shards;
+
+		std::atomic<uint64_t> nextConnectionId {0};
+		std::atomic<uint64_t> created {0};
+		std::atomic<uint64_t> released {0};
+		std::atomic<uint64_t> lockContentions {0};
+		std::atomic<uint64_t> lockWaitTime {0};
+
+		metrics::Gauge& activeConnections = metrics::Registry::getInstance().gauge("tfs_connections", "Open client connections");
+		metrics::Counter& acceptedConnections = metrics::Registry::getInstance().counter("tfs_connections_total", "Client connections created");
+		metrics::Histogram& contendedLockWait = metrics::Registry::getInstance().histogram("tfs_connection_lock_wait_seconds", "Time spent waiting for a contended connection manager lock");
 };
 
 class Connection : public std::enable_shared_from_this<Connection>
@@ -65,12 +98,14 @@ class Connection : public std::enable_shared_from_this<Connection>
 		enum { FORCE_CLOSE = true };
 
 		Connection(boost::asio::io_service& io_service,
-		ConstServicePort_ptr service_port) :
+		ConstServicePort_ptr service_port, uint64_t id) :
+			strand(io_service),
 			readTimer(io_service),
 			writeTimer(io_service),
 			service_port(std::move(service_port)),
 			socket(io_service),
-			timeConnected(time(nullptr)) {}
+			timeConnected(time(nullptr)),
+			id(id) {}
 		~Connection();
 
 		friend class ConnectionManager;
@@ -82,9 +117,15 @@ class Connection : public std::enable_shared_from_this<Connection>
 
 		void send(const OutputMessage_ptr& msg);
 
-		uint32_t getIP();
+		uint32_t getIP() const {
+			return remoteIP;
+		}
 
 	private:
+		void internalAccept();
+		void internalClose(bool force);
+		void readRemoteIP();
+
 		void parseHeader(const boost::system::error_code& error);
 		void parsePacket(const boost::system::error_code& error);
 
@@ -102,11 +143,12 @@ class Connection : public std::enable_shared_from_this<Connection>
 
 		NetworkMessage msg;
 
+		//every handler and state change of a connection runs through its strand
+		boost::asio::io_service::strand strand;
+
 		boost::asio::steady_timer readTimer;
 		boost::asio::steady_timer writeTimer;
 
-		std::recursive_mutex connectionLock;
-
 		std::list<OutputMessage_ptr> messageQueue;
 
 		ConstServicePort_ptr service_port;
@@ -116,6 +158,9 @@ class Connection : public std::enable_shared_from_this<Connection>
 
 		time_t timeConnected;
 		uint32_t packetsSent = 0;
+		uint32_t remoteIP = 0;
+
+		const uint64_t id;
 
 		ConnectionState_t connectionState = CONNECTION_STATE_PENDING;
 		bool receivedFirst = false;
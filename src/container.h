@@ -43,6 +43,13 @@ class Container : public Item, public Cylinder
 		Container(const Container&) = delete;
 		Container& operator=(const Container&) = delete;
 
+		static void* operator new(size_t size) {
+			return ObjectPool::allocate(size, POOLED_CONTAINER);
+		}
+		static void operator delete(void* p, size_t size) {
+			ObjectPool::deallocate(p, size, POOLED_CONTAINER);
+		}
+
 		Item* clone() const override;
 
 		Container* getContainer() override final {
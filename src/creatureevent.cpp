@@ -281,8 +281,7 @@ bool CreatureEvent::executeOnLogin(Player* player) const
 	lua_State* L = scriptInterface->getLuaState();
 
 	scriptInterface->pushFunction(scriptId);
-	LuaScriptInterface::pushUserdata(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata(L, player, LuaData_Player);
 	return scriptInterface->callFunction(1);
 }
 
@@ -300,8 +299,7 @@ bool CreatureEvent::executeOnLogout(Player* player) const
 	lua_State* L = scriptInterface->getLuaState();
 
 	scriptInterface->pushFunction(scriptId);
-	LuaScriptInterface::pushUserdata(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata(L, player, LuaData_Player);
 	return scriptInterface->callFunction(1);
 }
 
@@ -408,8 +406,7 @@ bool CreatureEvent::executeAdvance(Player* player, skills_t skill, uint32_t oldL
 	lua_State* L = scriptInterface->getLuaState();
 
 	scriptInterface->pushFunction(scriptId);
-	LuaScriptInterface::pushUserdata(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata(L, player, LuaData_Player);
 	lua_pushnumber(L, static_cast<uint32_t>(skill));
 	lua_pushnumber(L, oldLevel);
 	lua_pushnumber(L, newLevel);
@@ -452,8 +449,7 @@ void CreatureEvent::executeModalWindow(Player* player, uint32_t modalWindowId, u
 	lua_State* L = scriptInterface->getLuaState();
 	scriptInterface->pushFunction(scriptId);
 
-	LuaScriptInterface::pushUserdata(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata(L, player, LuaData_Player);
 
 	lua_pushnumber(L, modalWindowId);
 	lua_pushnumber(L, buttonId);
@@ -476,8 +472,7 @@ bool CreatureEvent::executeTextEdit(Player* player, Item* item, const std::strin
 	lua_State* L = scriptInterface->getLuaState();
 	scriptInterface->pushFunction(scriptId);
 
-	LuaScriptInterface::pushUserdata(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata(L, player, LuaData_Player);
 
 	LuaScriptInterface::pushThing(L, item);
 	LuaScriptInterface::pushString(L, text);
@@ -577,8 +572,7 @@ void CreatureEvent::executeExtendedOpcode(Player* player, uint8_t opcode, const
 
 	scriptInterface->pushFunction(scriptId);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	lua_pushnumber(L, opcode);
 	LuaScriptInterface::pushString(L, buffer);
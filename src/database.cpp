@@ -6,12 +6,20 @@
 #include "database.h"
 
 #include "configmanager.h"
+#include "metrics.h"
 #include "tasks.h"
 
 #include <mysql/errmsg.h>
 
 extern ConfigManager g_config;
 
+namespace {
+
+metrics::Histogram& queryDuration = metrics::Registry::getInstance().histogram("tfs_database_query_duration_seconds", "Time spent running database queries");
+metrics::Counter& queryErrors = metrics::Registry::getInstance().counter("tfs_database_query_errors_total", "Failed database query attempts");
+
+}
+
 Database::~Database()
 {
 	if (handle) {
@@ -81,6 +89,21 @@ bool Database::commit()
 	return true;
 }
 
+bool Database::executeTransaction(const std::vector<std::string>& queries)
+{
+	DBTransaction transaction(*this);
+	if (!transaction.begin()) {
+		return false;
+	}
+
+	for (const std::string& query : queries) {
+		if (!executeQuery(query)) {
+			return false;
+		}
+	}
+	return transaction.commit();
+}
+
 bool Database::executeQuery(const std::string& query)
 {
 	bool success = true;
@@ -88,11 +111,13 @@ bool Database::executeQuery(const std::string& query)
 	// executes the query
 	databaseLock.lock();
 
+	const auto start = std::chrono::steady_clock::now();
 #ifdef STATS_ENABLED
 	std::chrono::high_resolution_clock::time_point time_point = std::chrono::high_resolution_clock::now();
 #endif
 
 	while (mysql_real_query(handle, query.c_str(), query.length()) != 0) {
+		queryErrors.increment();
 		console::reportError("mysql_real_query", fmt::format("Query: {:s}\nMessage: {:s}", query.substr(0, 256), mysql_error(handle)));
 		auto error = mysql_errno(handle);
 		if (error != CR_SERVER_LOST && error != CR_SERVER_GONE_ERROR && error != CR_CONN_HOST_ERROR && error != 1053/*ER_SERVER_SHUTDOWN*/ && error != CR_CONNECTION_ERROR) {
@@ -104,6 +129,7 @@ bool Database::executeQuery(const std::string& query)
 
 	MYSQL_RES* m_res = mysql_store_result(handle);
 	databaseLock.unlock();
+	queryDuration.observe(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
 
 #ifdef STATS_ENABLED
 	uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - time_point).count();
@@ -121,12 +147,14 @@ DBResult_ptr Database::storeQuery(const std::string& query)
 {
 	databaseLock.lock();
 
+	const auto start = std::chrono::steady_clock::now();
 #ifdef STATS_ENABLED
 	std::chrono::high_resolution_clock::time_point time_point = std::chrono::high_resolution_clock::now();
 #endif
 
 	retry:
 	while (mysql_real_query(handle, query.c_str(), query.length()) != 0) {
+		queryErrors.increment();
 		console::reportError("mysql_real_query", fmt::format("Query: {:s}\nMessage: {:s}", query, mysql_error(handle)));
 		auto error = mysql_errno(handle);
 		if (error != CR_SERVER_LOST && error != CR_SERVER_GONE_ERROR && error != CR_CONN_HOST_ERROR && error != 1053/*ER_SERVER_SHUTDOWN*/ && error != CR_CONNECTION_ERROR) {
@@ -139,6 +167,7 @@ DBResult_ptr Database::storeQuery(const std::string& query)
 	// as it is described in MySQL manual: "it doesn't hurt" :P
 	MYSQL_RES* res = mysql_store_result(handle);
 	if (!res) {
+		queryErrors.increment();
 		console::reportError("mysql_store_result", fmt::format("Query: {:s}\nMessage: {:s}", query, mysql_error(handle)));
 		auto error = mysql_errno(handle);
 		if (error != CR_SERVER_LOST && error != CR_SERVER_GONE_ERROR && error != CR_CONN_HOST_ERROR && error != 1053/*ER_SERVER_SHUTDOWN*/ && error != CR_CONNECTION_ERROR) {
@@ -148,6 +177,7 @@ DBResult_ptr Database::storeQuery(const std::string& query)
 		goto retry;
 	}
 	databaseLock.unlock();
+	queryDuration.observe(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
 
 #ifdef STATS_ENABLED
 	uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - time_point).count();
@@ -191,12 +221,11 @@ DBResult::DBResult(MYSQL_RES* res)
 {
 	handle = res;
 
-	size_t i = 0;
-
-	MYSQL_FIELD* field = mysql_fetch_field(handle);
-	while (field) {
-		listNames[field->name] = i++;
-		field = mysql_fetch_field(handle);
+	unsigned int fieldCount = mysql_num_fields(handle);
+	MYSQL_FIELD* fields = mysql_fetch_fields(handle);
+	columnNames.reserve(fieldCount);
+	for (unsigned int i = 0; i < fieldCount; ++i) {
+		columnNames.emplace_back(fields[i].name, fields[i].name_length);
 	}
 
 	row = mysql_fetch_row(handle);
@@ -207,37 +236,58 @@ DBResult::~DBResult()
 	mysql_free_result(handle);
 }
 
-std::string DBResult::getString(const std::string& s) const
+size_t DBResult::getColumnIndex(std::string_view name) const
 {
-	auto it = listNames.find(s);
-	if (it == listNames.end()) {
-		console::reportError("DBResult::getString", fmt::format("Column '{:s}' does not exist in result set.", s));
-		return std::string();
+	//result sets have a handful of columns, a linear scan beats building a map for each of them
+	for (size_t i = 0, size = columnNames.size(); i < size; ++i) {
+		if (columnNames[i] == name) {
+			return i;
+		}
 	}
 
-	if (!row[it->second]) {
-		return std::string();
-	}
+	console::reportError("DBResult::getColumnIndex", fmt::format("Column '{:s}' does not exist in result set.", name));
+	return INVALID_COLUMN;
+}
 
-	return std::string(row[it->second]);
+std::string DBResult::getString(std::string_view name) const
+{
+	return std::string(getStringView(getColumnIndex(name)));
 }
 
-const char* DBResult::getStream(const std::string& s, unsigned long& size) const
+std::string DBResult::getString(size_t column) const
 {
-	auto it = listNames.find(s);
-	if (it == listNames.end()) {
-		console::reportError("DBResult::getStream", fmt::format("Column '{:s}' does not exist in result set.", s));
-		size = 0;
-		return nullptr;
+	return std::string(getStringView(column));
+}
+
+std::string_view DBResult::getStringView(std::string_view name) const
+{
+	return getStringView(getColumnIndex(name));
+}
+
+std::string_view DBResult::getStringView(size_t column) const
+{
+	unsigned long size;
+	const char* data = getStream(column, size);
+	if (!data) {
+		return {};
 	}
+	return {data, size};
+}
+
+const char* DBResult::getStream(std::string_view name, unsigned long& size) const
+{
+	return getStream(getColumnIndex(name), size);
+}
 
-	if (!row[it->second]) {
+const char* DBResult::getStream(size_t column, unsigned long& size) const
+{
+	if (column >= columnNames.size() || !row[column]) {
 		size = 0;
 		return nullptr;
 	}
 
-	size = mysql_fetch_lengths(handle)[it->second];
-	return row[it->second];
+	size = mysql_fetch_lengths(handle)[column];
+	return row[column];
 }
 
 bool DBResult::hasNext() const
@@ -256,6 +306,11 @@ DBInsert::DBInsert(std::string query) : query(std::move(query))
 	this->length = this->query.length();
 }
 
+DBInsert::DBInsert(std::string query, std::vector<std::string>& output) : query(std::move(query)), output(&output)
+{
+	this->length = this->query.length();
+}
+
 bool DBInsert::addRow(const std::string& row)
 {
 	// adds new row to buffer
@@ -293,6 +348,13 @@ bool DBInsert::execute()
 		return true;
 	}
 
+	if (output) {
+		output->push_back(query + values);
+		values.clear();
+		length = query.length();
+		return true;
+	}
+
 	// executes buffer
 	bool res = Database::getInstance().executeQuery(query + values);
 	values.clear();
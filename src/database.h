@@ -56,6 +56,14 @@ class Database
 		 */
 		DBResult_ptr storeQuery(const std::string& query);
 
+		/**
+		 * Executes commands in one transaction.
+		 *
+		 * @param queries commands, executed in order
+		 * @return true when all of them succeeded and were committed
+		 */
+		bool executeTransaction(const std::vector<std::string>& queries);
+
 		/**
 		 * Escapes string for query.
 		 *
@@ -121,6 +129,8 @@ class Database
 class DBResult
 {
 	public:
+		static constexpr size_t INVALID_COLUMN = std::numeric_limits<size_t>::max();
+
 		explicit DBResult(MYSQL_RES* res);
 		~DBResult();
 
@@ -128,34 +138,63 @@ class DBResult
 		DBResult(const DBResult&) = delete;
 		DBResult& operator=(const DBResult&) = delete;
 
+		// resolves a column once, so loops over many rows can skip the name lookup
+		size_t getColumnIndex(std::string_view name) const;
+
 		template<typename T>
-		T getNumber(const std::string& s) const
+		T getNumber(std::string_view name) const
 		{
-			auto it = listNames.find(s);
-			if (it == listNames.end()) {
-				console::reportError("DBResult::getNumber", fmt::format("Column '{:s}' does not exist in result set.", s));
-
-				return {};
-			}
+			return getNumber<T>(getColumnIndex(name));
+		}
 
-			if (!row[it->second]) {
+		template<typename T>
+		T getNumber(size_t column) const
+		{
+			if (column >= columnNames.size() || !row[column]) {
 				return {};
 			}
-
-			return pugi::cast<T>(row[it->second]);
+			return parseNumber<T>(row[column]);
 		}
 
-		std::string getString(const std::string& s) const;
-		const char* getStream(const std::string& s, unsigned long& size) const;
+		std::string getString(std::string_view name) const;
+		std::string getString(size_t column) const;
+		// points into the row, valid until the next call to next()
+		std::string_view getStringView(std::string_view name) const;
+		std::string_view getStringView(size_t column) const;
+		const char* getStream(std::string_view name, unsigned long& size) const;
+		const char* getStream(size_t column, unsigned long& size) const;
 
 		bool hasNext() const;
 		bool next();
 
 	private:
+		// integers are read the way strtol/strtoul did: negative text wraps around for unsigned types
+		template<typename T>
+		static T parseNumber(const char* str)
+		{
+			if constexpr (std::is_enum_v<T>) {
+				return static_cast<T>(parseNumber<std::underlying_type_t<T>>(str));
+			} else if constexpr (std::is_floating_point_v<T>) {
+				return static_cast<T>(std::strtod(str, nullptr));
+			} else {
+				const char* last = str + std::strlen(str);
+				if (*str == '-') {
+					int64_t value = 0;
+					std::from_chars(str, last, value);
+					return static_cast<T>(value);
+				}
+
+				uint64_t value = 0;
+				std::from_chars(str, last, value);
+				return static_cast<T>(value);
+			}
+		}
+
 		MYSQL_RES* handle;
 		MYSQL_ROW row;
 
-		std::map<std::string, size_t> listNames;
+		// names point into the field data owned by handle
+		std::vector<std::string_view> columnNames;
 
 	friend class Database;
 };
@@ -167,6 +206,8 @@ class DBInsert
 {
 	public:
 		explicit DBInsert(std::string query);
+		// collects the statements into output instead of executing them
+		DBInsert(std::string query, std::vector<std::string>& output);
 		bool addRow(const std::string& row);
 		bool addRow(std::ostringstream& row);
 		bool execute();
@@ -174,17 +215,19 @@ class DBInsert
 	private:
 		std::string query;
 		std::string values;
+		std::vector<std::string>* output = nullptr;
 		size_t length;
 };
 
 class DBTransaction
 {
 	public:
-		constexpr DBTransaction() = default;
+		DBTransaction() : db(Database::getInstance()) {}
+		explicit DBTransaction(Database& db) : db(db) {}
 
 		~DBTransaction() {
 			if (state == STATE_START) {
-				Database::getInstance().rollback();
+				db.rollback();
 			}
 		}
 
@@ -194,7 +237,7 @@ class DBTransaction
 
 		bool begin() {
 			state = STATE_START;
-			return Database::getInstance().beginTransaction();
+			return db.beginTransaction();
 		}
 
 		bool commit() {
@@ -203,7 +246,7 @@ class DBTransaction
 			}
 
 			state = STATE_COMMIT;
-			return Database::getInstance().commit();
+			return db.commit();
 		}
 
 	private:
@@ -213,6 +256,7 @@ class DBTransaction
 			STATE_COMMIT,
 		};
 
+		Database& db;
 		TransactionStates_t state = STATE_NO_START;
 };
 
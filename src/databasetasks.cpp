@@ -4,61 +4,183 @@
 #include "otpch.h"
 
 #include "databasetasks.h"
+#include "configmanager.h"
 #include "tasks.h"
 
+extern ConfigManager g_config;
 extern Dispatcher g_dispatcher;
 
+namespace {
+
+// length of "INSERT INTO `t` (...) VALUES " when the rest of the query is one row, 0 otherwise
+size_t getInsertPrefixLength(const DatabaseTask& task)
+{
+	static const std::string insert = "INSERT INTO ";
+	static const std::string values = " VALUES ";
+
+	if (task.job || task.callback || task.store || task.query.compare(0, insert.size(), insert) != 0) {
+		return 0;
+	}
+
+	size_t pos = task.query.find(values);
+	if (pos == std::string::npos) {
+		return 0;
+	}
+
+	pos += values.size();
+	if (task.query[pos] != '(' || task.query.back() != ')' || task.query.find("ON DUPLICATE", pos) != std::string::npos) {
+		return 0;
+	}
+	return pos;
+}
+
+}
+
 void DatabaseTasks::start()
 {
-	db.connect();
+	const auto workerCount = static_cast<size_t>(std::max<int32_t>(1, g_config.getNumber(ConfigManager::DATABASE_WORKERS)));
+	metrics::Registry& registry = metrics::Registry::getInstance();
+	for (size_t i = 0; i < workerCount; ++i) {
+		auto worker = std::make_unique<Worker>();
+		worker->db.connect();
+		worker->queueSize = &registry.gauge("tfs_database_task_queue_size", "Database tasks waiting to be run", fmt::format("worker=\"{:d}\"", i));
+		workers.push_back(std::move(worker));
+	}
+
 	ThreadHolder::start();
+	for (size_t i = 1; i < workers.size(); ++i) {
+		workers[i]->thread = std::thread(&DatabaseTasks::workerMain, this, std::ref(*workers[i]));
+	}
 }
 
 void DatabaseTasks::threadMain()
 {
-	std::unique_lock<std::mutex> taskLockUnique(taskLock, std::defer_lock);
+	workerMain(*workers.front());
+}
+
+void DatabaseTasks::workerMain(Worker& worker)
+{
+	std::vector<DatabaseTask> batch;
+	std::unique_lock<std::mutex> taskLockUnique(worker.taskLock, std::defer_lock);
 	while (getState() != THREAD_STATE_TERMINATED) {
 		taskLockUnique.lock();
-		if (tasks.empty()) {
-			taskSignal.wait(taskLockUnique);
+		if (worker.tasks.empty() && getState() != THREAD_STATE_TERMINATED) {
+			worker.taskSignal.wait(taskLockUnique);
 		}
 
-		if (!tasks.empty()) {
-			DatabaseTask task = std::move(tasks.front());
-			tasks.pop_front();
+		if (!worker.tasks.empty()) {
+			takeTasks(worker, batch);
 			taskLockUnique.unlock();
-			runTask(task);
+			runTasks(worker, batch);
 		} else {
 			taskLockUnique.unlock();
 		}
 	}
 }
 
-void DatabaseTasks::addTask(std::string query, std::function<void(DBResult_ptr, bool)> callback/* = nullptr*/, bool store/* = false*/)
+void DatabaseTasks::addTask(std::string query, std::function<void(DBResult_ptr, bool)> callback/* = nullptr*/, bool store/* = false*/, uint32_t orderingKey/* = NO_ORDERING_KEY*/)
+{
+	addTask(DatabaseTask(std::move(query), std::move(callback), store), orderingKey);
+}
+
+bool DatabaseTasks::addJob(std::function<void(Database&)> job, uint32_t orderingKey/* = NO_ORDERING_KEY*/)
+{
+	return addTask(DatabaseTask(std::move(job)), orderingKey);
+}
+
+bool DatabaseTasks::addTask(DatabaseTask&& task, uint32_t orderingKey)
 {
+	if (workers.empty()) {
+		return false;
+	}
+
+	Worker& worker = *workers[orderingKey % workers.size()];
+
 	bool signal = false;
-	taskLock.lock();
-	if (getState() == THREAD_STATE_RUNNING) {
-		signal = tasks.empty();
-		tasks.emplace_back(std::move(query), std::move(callback), store);
+	worker.taskLock.lock();
+	bool running = getState() == THREAD_STATE_RUNNING;
+	if (running) {
+		signal = worker.tasks.empty();
+		task.queuedAt = std::chrono::steady_clock::now();
+		worker.tasks.push_back(std::move(task));
+		worker.queueSize->set(worker.tasks.size());
 	}
-	taskLock.unlock();
+	worker.taskLock.unlock();
 
 	if (signal) {
-		taskSignal.notify_one();
+		worker.taskSignal.notify_one();
 	}
+	return running;
 }
 
-void DatabaseTasks::runTask(const DatabaseTask& task)
+void DatabaseTasks::takeTasks(Worker& worker, std::vector<DatabaseTask>& batch)
 {
+	batch.push_back(std::move(worker.tasks.front()));
+	worker.tasks.pop_front();
+
+	const DatabaseTask& first = batch.front();
+	if (size_t prefixLength = getInsertPrefixLength(first)) {
+		while (!worker.tasks.empty() && batch.size() < MAX_BATCH_ROWS) {
+			const DatabaseTask& next = worker.tasks.front();
+			if (getInsertPrefixLength(next) != prefixLength || next.query.compare(0, prefixLength, first.query, 0, prefixLength) != 0) {
+				break;
+			}
+
+			batch.push_back(std::move(worker.tasks.front()));
+			worker.tasks.pop_front();
+		}
+	}
+
+	worker.queueSize->set(worker.tasks.size());
+}
+
+void DatabaseTasks::runTasks(Worker& worker, std::vector<DatabaseTask>& batch)
+{
+	const auto now = std::chrono::steady_clock::now();
+	for (const DatabaseTask& task : batch) {
+		queueLatency.observe(std::chrono::duration_cast<std::chrono::nanoseconds>(now - task.queuedAt));
+	}
+
+	if (batch.size() > 1) {
+		metrics::ScopedTimer timer(taskDuration);
+
+		const size_t prefixLength = getInsertPrefixLength(batch.front());
+		std::string query = batch.front().query;
+		for (auto it = std::next(batch.begin()); it != batch.end(); ++it) {
+			query.push_back(',');
+			query.append(it->query, prefixLength, std::string::npos);
+		}
+
+		if (worker.db.executeQuery(query)) {
+			batchedRows.increment(batch.size());
+			batch.clear();
+			return;
+		}
+		//one bad row fails the whole statement, the others still go in on their own
+	}
+
+	for (const DatabaseTask& task : batch) {
+		runTask(worker, task);
+	}
+	batch.clear();
+}
+
+void DatabaseTasks::runTask(Worker& worker, const DatabaseTask& task)
+{
+	metrics::ScopedTimer timer(taskDuration);
+	if (task.job) {
+		task.job(worker.db);
+		return;
+	}
+
 	bool success;
 	DBResult_ptr result;
 	if (task.store) {
-		result = db.storeQuery(task.query);
+		result = worker.db.storeQuery(task.query);
 		success = true;
 	} else {
 		result = nullptr;
-		success = db.executeQuery(task.query);
+		success = worker.db.executeQuery(task.query);
 	}
 
 	if (task.callback) {
@@ -68,21 +190,38 @@ void DatabaseTasks::runTask(const DatabaseTask& task)
 
 void DatabaseTasks::flush()
 {
-	std::unique_lock<std::mutex> guard{ taskLock };
-	while (!tasks.empty()) {
-		auto task = std::move(tasks.front());
-		tasks.pop_front();
-		guard.unlock();
-		runTask(task);
-		guard.lock();
+	//everything queued so far runs on the calling thread, a worker's connection is locked while in use
+	std::vector<DatabaseTask> batch;
+	for (const auto& worker : workers) {
+		std::unique_lock<std::mutex> guard{ worker->taskLock };
+		while (!worker->tasks.empty()) {
+			takeTasks(*worker, batch);
+			guard.unlock();
+			runTasks(*worker, batch);
+			guard.lock();
+		}
 	}
 }
 
 void DatabaseTasks::shutdown()
 {
-	taskLock.lock();
 	setState(THREAD_STATE_TERMINATED);
-	taskLock.unlock();
 	flush();
-	taskSignal.notify_one();
+
+	for (const auto& worker : workers) {
+		//taking the lock makes sure a worker is either waiting or sees the new state
+		worker->taskLock.lock();
+		worker->taskLock.unlock();
+		worker->taskSignal.notify_one();
+	}
+}
+
+void DatabaseTasks::join()
+{
+	ThreadHolder::join();
+	for (const auto& worker : workers) {
+		if (worker->thread.joinable()) {
+			worker->thread.join();
+		}
+	}
 }
@@ -5,36 +5,75 @@
 #define FS_DATABASETASKS_H
 
 #include "database.h"
+#include "metrics.h"
 #include "thread_holder_base.h"
 
 struct DatabaseTask {
 	DatabaseTask(std::string&& query, std::function<void(DBResult_ptr, bool)>&& callback, bool store) :
 		query(std::move(query)), callback(std::move(callback)), store(store) {}
+	explicit DatabaseTask(std::function<void(Database&)>&& job) :
+		job(std::move(job)) {}
 
 	std::string query;
 	std::function<void(DBResult_ptr, bool)> callback;
-	bool store;
+	std::function<void(Database&)> job;
+	bool store = false;
+	std::chrono::steady_clock::time_point queuedAt;
 };
 
+/*
+ * queued queries run on a pool of workers, each with its own connection.
+ * The ordering key picks the worker, so tasks sharing a key (e.g. a player
+ * guid) run in the order they were added while other keys run in parallel;
+ * tasks without a key all share the first worker and keep their order
+ */
 class DatabaseTasks : public ThreadHolder<DatabaseTasks>
 {
 	public:
+		static constexpr uint32_t NO_ORDERING_KEY = 0;
+		// adjacent single row INSERTs into the same columns are sent as one statement
+		static constexpr size_t MAX_BATCH_ROWS = 64;
+
 		DatabaseTasks() = default;
+
+		// ordering key for writes that only have to stay ordered per table
+		static uint32_t getTableKey(const std::string& table) {
+			return static_cast<uint32_t>(std::hash<std::string>()(table));
+		}
+
 		void start();
 		void flush();
 		void shutdown();
+		void join();
 
-		void addTask(std::string query, std::function<void(DBResult_ptr, bool)> callback = nullptr, bool store = false);
+		void addTask(std::string query, std::function<void(DBResult_ptr, bool)> callback = nullptr, bool store = false, uint32_t orderingKey = NO_ORDERING_KEY);
+		// runs job with the worker's connection on its thread, false once shut down
+		bool addJob(std::function<void(Database&)> job, uint32_t orderingKey = NO_ORDERING_KEY);
 
+		// the ThreadHolder thread runs the first worker
 		void threadMain();
 	private:
-		void runTask(const DatabaseTask& task);
+		struct Worker {
+			Database db;
+			std::thread thread;
+			std::deque<DatabaseTask> tasks;
+			std::mutex taskLock;
+			std::condition_variable taskSignal;
+			metrics::Gauge* queueSize = nullptr;
+		};
+
+		bool addTask(DatabaseTask&& task, uint32_t orderingKey);
+		void workerMain(Worker& worker);
+		// moves the next task, and the INSERTs it can be batched with, out of the queue; taskLock must be held
+		void takeTasks(Worker& worker, std::vector<DatabaseTask>& batch);
+		void runTasks(Worker& worker, std::vector<DatabaseTask>& batch);
+		void runTask(Worker& worker, const DatabaseTask& task);
+
+		std::vector<std::unique_ptr<Worker>> workers;
 
-		Database db;
-		std::thread thread;
-		std::list<DatabaseTask> tasks;
-		std::mutex taskLock;
-		std::condition_variable taskSignal;
+		metrics::Histogram& taskDuration = metrics::Registry::getInstance().histogram("tfs_database_task_duration_seconds", "Time spent running queued database tasks");
+		metrics::Histogram& queueLatency = metrics::Registry::getInstance().histogram("tfs_database_task_queue_latency_seconds", "Time database tasks wait before a worker runs them");
+		metrics::Counter& batchedRows = metrics::Registry::getInstance().counter("tfs_database_batched_rows_total", "INSERT rows sent as part of a multi row statement");
 };
 
 extern DatabaseTasks g_databaseTasks;
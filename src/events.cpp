@@ -217,8 +217,7 @@ bool Events::eventMonsterOnSpawn(Monster* monster, const Position& position, boo
 	// set monster ID earlier than usual so we can reference it in the script
 	monster->setID();
 
-	LuaScriptInterface::pushUserdata<Monster>(L, monster);
-	LuaScriptInterface::setMetatable(L, -1, "Monster");
+	LuaScriptInterface::pushUserdata<Monster>(L, monster, LuaData_Monster);
 	LuaScriptInterface::pushPosition(L, position);
 	LuaScriptInterface::pushBoolean(L, startup);
 	LuaScriptInterface::pushBoolean(L, artificial);
@@ -278,8 +277,7 @@ ReturnValue Events::eventCreatureOnAreaCombat(Creature* creature, Tile* tile, bo
 		lua_pushnil(L);
 	}
 
-	LuaScriptInterface::pushUserdata<Tile>(L, tile);
-	LuaScriptInterface::setMetatable(L, -1, "Tile");
+	LuaScriptInterface::pushUserdata<Tile>(L, tile, LuaData_Tile);
 
 	LuaScriptInterface::pushBoolean(L, aggressive);
 
@@ -436,8 +434,7 @@ bool Events::eventPartyOnJoin(Party* party, Player* player)
 	LuaScriptInterface::pushUserdata<Party>(L, party);
 	LuaScriptInterface::setMetatable(L, -1, "Party");
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	return scriptInterface.callFunction(2);
 }
@@ -463,8 +460,7 @@ bool Events::eventPartyOnLeave(Party* party, Player* player)
 	LuaScriptInterface::pushUserdata<Party>(L, party);
 	LuaScriptInterface::setMetatable(L, -1, "Party");
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	return scriptInterface.callFunction(2);
 }
@@ -545,8 +541,7 @@ bool Events::eventPlayerOnBrowseField(Player* player, const Position& position)
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnBrowseField);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	LuaScriptInterface::pushPosition(L, position);
 
@@ -571,8 +566,7 @@ void Events::eventPlayerOnLook(Player* player, const Position& position, Thing*
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnLook);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	if (Creature* creature = thing->getCreature()) {
 		LuaScriptInterface::pushUserdata<Creature>(L, creature);
@@ -608,8 +602,7 @@ void Events::eventPlayerOnLookInBattleList(Player* player, Creature* creature, i
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnLookInBattleList);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	LuaScriptInterface::pushUserdata<Creature>(L, creature);
 	LuaScriptInterface::setCreatureMetatable(L, -1, creature);
@@ -637,11 +630,9 @@ void Events::eventPlayerOnLookInTrade(Player* player, Player* partner, Item* ite
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnLookInTrade);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
-	LuaScriptInterface::pushUserdata<Player>(L, partner);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, partner, LuaData_Player);
 
 	LuaScriptInterface::pushUserdata<Item>(L, item);
 	LuaScriptInterface::setItemMetatable(L, -1, item);
@@ -669,16 +660,14 @@ bool Events::eventPlayerOnLookInShop(Player* player, const ItemType* itemType, u
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnLookInShop);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	LuaScriptInterface::pushUserdata<const ItemType>(L, itemType);
 	LuaScriptInterface::setMetatable(L, -1, "ItemType");
 
 	lua_pushnumber(L, count);
 
-	LuaScriptInterface::pushUserdata<Npc>(L, npc);
-	LuaScriptInterface::setMetatable(L, -1, "Npc");
+	LuaScriptInterface::pushUserdata<Npc>(L, npc, LuaData_Npc);
 
 	return scriptInterface.callFunction(4);
 }
@@ -701,8 +690,7 @@ bool Events::eventPlayerOnLookInMarket(Player* player, const ItemType* itemType,
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnLookInMarket);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	LuaScriptInterface::pushUserdata<const ItemType>(L, itemType);
 	LuaScriptInterface::setMetatable(L, -1, "ItemType");
@@ -730,8 +718,7 @@ ReturnValue Events::eventPlayerOnMoveItem(Player* player, Item* item, uint16_t c
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnMoveItem);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	LuaScriptInterface::pushUserdata<Item>(L, item);
 	LuaScriptInterface::setItemMetatable(L, -1, item);
@@ -774,8 +761,7 @@ void Events::eventPlayerOnItemMoved(Player* player, Item* item, uint16_t count,
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnItemMoved);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	if (item) {
 		LuaScriptInterface::pushUserdata<Item>(L, item);
@@ -812,8 +798,7 @@ bool Events::eventPlayerOnMoveCreature(Player* player, Creature* creature, const
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnMoveCreature);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	LuaScriptInterface::pushUserdata<Creature>(L, creature);
 	LuaScriptInterface::setCreatureMetatable(L, -1, creature);
@@ -842,8 +827,7 @@ void Events::eventPlayerOnReportRuleViolation(Player* player, const std::string&
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnReportRuleViolation);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	LuaScriptInterface::pushString(L, targetName);
 
@@ -874,8 +858,7 @@ bool Events::eventPlayerOnReportBug(Player* player, const std::string& message,
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnReportBug);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	LuaScriptInterface::pushString(L, message);
 	LuaScriptInterface::pushPosition(L, position);
@@ -902,8 +885,7 @@ bool Events::eventPlayerOnTurn(Player* player, Direction direction)
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnTurn);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	lua_pushnumber(L, direction);
 
@@ -928,11 +910,9 @@ bool Events::eventPlayerOnTradeRequest(Player* player, Player* target, Item* ite
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnTradeRequest);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
-	LuaScriptInterface::pushUserdata<Player>(L, target);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, target, LuaData_Player);
 
 	LuaScriptInterface::pushUserdata<Item>(L, item);
 	LuaScriptInterface::setItemMetatable(L, -1, item);
@@ -958,11 +938,9 @@ bool Events::eventPlayerOnTradeAccept(Player* player, Player* target, Item* item
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnTradeAccept);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
-	LuaScriptInterface::pushUserdata<Player>(L, target);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, target, LuaData_Player);
 
 	LuaScriptInterface::pushUserdata<Item>(L, item);
 	LuaScriptInterface::setItemMetatable(L, -1, item);
@@ -991,11 +969,9 @@ void Events::eventPlayerOnTradeCompleted(Player* player, Player* target, Item* i
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnTradeCompleted);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
-	LuaScriptInterface::pushUserdata<Player>(L, target);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, target, LuaData_Player);
 
 	LuaScriptInterface::pushUserdata<Item>(L, item);
 	LuaScriptInterface::setItemMetatable(L, -1, item);
@@ -1026,8 +1002,7 @@ void Events::eventPlayerOnPodiumRequest(Player* player, Item* item)
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnPodiumRequest);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	LuaScriptInterface::pushUserdata<Item>(L, item);
 	LuaScriptInterface::setItemMetatable(L, -1, item);
@@ -1053,8 +1028,7 @@ void Events::eventPlayerOnPodiumEdit(Player* player, Item* item, const Outfit_t&
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnPodiumEdit);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	LuaScriptInterface::pushUserdata<Item>(L, item);
 	LuaScriptInterface::setItemMetatable(L, -1, item);
@@ -1086,8 +1060,7 @@ void Events::eventPlayerOnGainExperience(Player* player, Creature* source, uint6
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnGainExperience);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	if (source) {
 		LuaScriptInterface::pushUserdata<Creature>(L, source);
@@ -1127,8 +1100,7 @@ void Events::eventPlayerOnLoseExperience(Player* player, uint64_t& exp)
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnLoseExperience);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	lua_pushnumber(L, exp);
 
@@ -1160,8 +1132,7 @@ void Events::eventPlayerOnGainSkillTries(Player* player, skills_t skill, uint64_
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnGainSkillTries);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	lua_pushnumber(L, skill);
 	lua_pushnumber(L, tries);
@@ -1194,8 +1165,7 @@ void Events::eventPlayerOnWrapItem(Player* player, Item* item)
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnWrapItem);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	LuaScriptInterface::pushUserdata<Item>(L, item);
 	LuaScriptInterface::setItemMetatable(L, -1, item);
@@ -1221,8 +1191,7 @@ void Events::eventPlayerOnQuickLoot(Player* player, const Position& position, ui
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnQuickLoot);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	LuaScriptInterface::pushPosition(L, position);
 	lua_pushnumber(L, stackPos);
@@ -1249,8 +1218,7 @@ void Events::eventPlayerOnInspectItem(Player* player, Item* item)
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnInspectItem);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	LuaScriptInterface::pushUserdata<Item>(L, item);
 	LuaScriptInterface::setItemMetatable(L, -1, item);
@@ -1276,11 +1244,9 @@ void Events::eventPlayerOnInspectTradeItem(Player* player, Player* tradePartner,
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnInspectTradeItem);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
-	LuaScriptInterface::pushUserdata<Player>(L, tradePartner);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, tradePartner, LuaData_Player);
 
 	LuaScriptInterface::pushUserdata<Item>(L, item);
 	LuaScriptInterface::setItemMetatable(L, -1, item);
@@ -1306,11 +1272,9 @@ void Events::eventPlayerOnInspectNpcTradeItem(Player* player, Npc* npc, uint16_t
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnInspectNpcTradeItem);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
-	LuaScriptInterface::pushUserdata<Npc>(L, npc);
-	LuaScriptInterface::setMetatable(L, -1, "Npc");
+	LuaScriptInterface::pushUserdata<Npc>(L, npc, LuaData_Npc);
 
 	lua_pushnumber(L, itemId);
 
@@ -1335,8 +1299,7 @@ void Events::eventPlayerOnInspectCyclopediaItem(Player* player, uint16_t itemId)
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnInspectCyclopediaItem);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	lua_pushnumber(L, itemId);
 
@@ -1361,8 +1324,7 @@ void Events::eventPlayerOnMinimapQuery(Player* player, const Position& position)
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnMinimapQuery);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	LuaScriptInterface::pushPosition(L, position);
 
@@ -1387,8 +1349,7 @@ void Events::eventPlayerOnInventoryUpdate(Player* player, Item* item, slots_t sl
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnInventoryUpdate);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	if (item) {
 		LuaScriptInterface::pushUserdata<Item>(L, item);
@@ -1421,8 +1382,7 @@ const std::string Events::eventPlayerOnGuildMotdEdit(Player* player, const std::
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnGuildMotdEdit);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	LuaScriptInterface::pushString(L, message);
 
@@ -1456,8 +1416,7 @@ void Events::eventPlayerOnSetLootList(Player* player, const std::vector<uint16_t
 	scriptInterface.pushFunction(info.playerOnSetLootList);
 
 	// player
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	// lootList
 	lua_createtable(L, lootList.size(), 0);
@@ -1492,17 +1451,14 @@ void Events::eventPlayerOnManageLootContainer(Player* player, Item* item, uint8_
 	scriptInterface.pushFunction(info.playerOnManageLootContainer);
 
 	// player
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	// item
 	if (item) {
 		if (Container* container = item->getContainer()) {
-			LuaScriptInterface::pushUserdata<Container>(L, container);
-			LuaScriptInterface::setMetatable(L, -1, "Container");
+			LuaScriptInterface::pushUserdata<Container>(L, container, LuaData_Container);
 		} else {
-			LuaScriptInterface::pushUserdata<Item>(L, item);
-			LuaScriptInterface::setMetatable(L, -1, "Item");
+			LuaScriptInterface::pushUserdata<Item>(L, item, LuaData_Item);
 		}
 	} else {
 		lua_pushnil(L);
@@ -1536,8 +1492,7 @@ void Events::eventPlayerOnFuseItems(Player* player, const ItemType* fromItemType
 	scriptInterface.pushFunction(info.playerOnFuseItems);
 
 	// player
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	// fromItemType
 	LuaScriptInterface::pushUserdata<const ItemType>(L, fromItemType);
@@ -1578,8 +1533,7 @@ void Events::eventPlayerOnTransferTier(Player* player, const ItemType* fromItemT
 	scriptInterface.pushFunction(info.playerOnTransferTier);
 
 	// player
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	// fromItemType
 	LuaScriptInterface::pushUserdata<const ItemType>(L, fromItemType);
@@ -1614,8 +1568,7 @@ void Events::eventPlayerOnForgeConversion(Player* player, ForgeConversionTypes_t
 	scriptInterface.pushFunction(info.playerOnForgeConversion);
 
 	// player
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	// conversionType
 	lua_pushnumber(L, conversionType);
@@ -1642,8 +1595,7 @@ void Events::eventPlayerOnForgeHistoryBrowse(Player* player, uint8_t page)
 	scriptInterface.pushFunction(info.playerOnForgeHistoryBrowse);
 
 	// player
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	// conversionType
 	lua_pushnumber(L, page);
@@ -1670,12 +1622,10 @@ void Events::eventPlayerOnRequestPlayerTab(Player* player, Player* targetPlayer,
 	scriptInterface.pushFunction(info.playerOnRequestPlayerTab);
 
 	// player
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	// target
-	LuaScriptInterface::pushUserdata<Player>(L, targetPlayer);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, targetPlayer, LuaData_Player);
 
 	// infoType
 	lua_pushnumber(L, infoType);
@@ -1708,8 +1658,7 @@ void Events::eventPlayerOnBestiaryInit(Player* player)
 	scriptInterface.pushFunction(info.playerOnBestiaryInit);
 
 	// player
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	scriptInterface.callVoidFunction(1);
 }
@@ -1733,8 +1682,7 @@ void Events::eventPlayerOnBestiaryBrowse(Player* player, const std::string& cate
 	scriptInterface.pushFunction(info.playerOnBestiaryBrowse);
 
 	// player
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	// category
 	lua_pushstring(L, category.c_str());
@@ -1769,8 +1717,7 @@ void Events::eventPlayerOnBestiaryRaceView(Player* player, uint16_t raceId)
 	scriptInterface.pushFunction(info.playerOnBestiaryRaceView);
 
 	// player
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	// raceId
 	lua_pushnumber(L, raceId);
@@ -1799,8 +1746,7 @@ uint8_t Events::eventPlayerOnFrameView(Player* player, const Creature* target)
 	scriptInterface.pushFunction(info.playerOnFrameView);
 
 	// player
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	// target
 	lua_pushnumber(L, target->getID());
@@ -1835,8 +1781,7 @@ void Events::eventPlayerOnImbuementApply(Player* player, uint8_t slotId, uint8_t
 	scriptInterface.pushFunction(info.playerOnImbuementApply);
 
 	// player
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	// slotId
 	lua_pushnumber(L, slotId);
@@ -1869,8 +1814,7 @@ void Events::eventPlayerOnImbuementClear(Player* player, uint8_t slotId)
 	scriptInterface.pushFunction(info.playerOnImbuementClear);
 
 	// player
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	lua_pushnumber(L, slotId);
 
@@ -1896,8 +1840,7 @@ void Events::eventPlayerOnImbuementExit(Player* player)
 	scriptInterface.pushFunction(info.playerOnImbuementExit);
 
 	// player
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	scriptInterface.callVoidFunction(1);
 }
@@ -1921,8 +1864,7 @@ void Events::eventPlayerOnDressOtherCreatureRequest(Player* player, Creature* ta
 	scriptInterface.pushFunction(info.playerOnDressOtherCreatureRequest);
 
 	// player
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	// target
 	LuaScriptInterface::pushUserdata<Creature>(L, target);
@@ -1950,8 +1892,7 @@ void Events::eventPlayerOnDressOtherCreature(Player* player, Creature* target, c
 	scriptInterface.pushFunction(info.playerOnDressOtherCreature);
 
 	// player
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	// target
 	LuaScriptInterface::pushUserdata<Creature>(L, target);
@@ -1982,8 +1923,7 @@ void Events::eventPlayerOnUseCreature(Player* player, Creature* target)
 	scriptInterface.pushFunction(info.playerOnUseCreature);
 
 	// player
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	// target
 	LuaScriptInterface::pushUserdata<Creature>(L, target);
@@ -2011,8 +1951,7 @@ void Events::eventPlayerOnEditName(Player* player, Creature* target, const std::
 	scriptInterface.pushFunction(info.playerOnEditName);
 
 	// player
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	// target
 	LuaScriptInterface::pushUserdata<Creature>(L, target);
@@ -2043,8 +1982,7 @@ void Events::eventPlayerOnStoreBrowse(Player* player, GameStoreRequest& request)
 	scriptInterface.pushFunction(info.playerOnStoreBrowse);
 
 	// player
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	// request
 	LuaScriptInterface::pushStoreRequest(L, request);
@@ -2071,8 +2009,7 @@ void Events::eventPlayerOnStoreBuy(Player* player, uint16_t offerId, uint8_t act
 	scriptInterface.pushFunction(info.playerOnStoreBuy);
 
 	// player
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	// offerId
 	lua_pushnumber(L, offerId);
@@ -2111,8 +2048,7 @@ void Events::eventPlayerOnStoreHistoryBrowse(Player* player, uint32_t pageId, bo
 	scriptInterface.pushFunction(info.playerOnStoreHistoryBrowse);
 
 	// player
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	// pageId
 	lua_pushnumber(L, pageId);
@@ -2141,8 +2077,7 @@ void Events::eventPlayerOnConnect(Player* player, bool isLogin)
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.playerOnConnect);
 
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 
 	lua_pushboolean(L, isLogin);
 	scriptInterface.callVoidFunction(2);
@@ -2166,11 +2101,9 @@ void Events::eventMonsterOnDropLoot(Monster* monster, Container* corpse)
 	lua_State* L = scriptInterface.getLuaState();
 	scriptInterface.pushFunction(info.monsterOnDropLoot);
 
-	LuaScriptInterface::pushUserdata<Monster>(L, monster);
-	LuaScriptInterface::setMetatable(L, -1, "Monster");
+	LuaScriptInterface::pushUserdata<Monster>(L, monster, LuaData_Monster);
 
-	LuaScriptInterface::pushUserdata<Container>(L, corpse);
-	LuaScriptInterface::setMetatable(L, -1, "Container");
+	LuaScriptInterface::pushUserdata<Container>(L, corpse, LuaData_Container);
 
 	return scriptInterface.callVoidFunction(2);
 }
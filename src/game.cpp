@@ -19,13 +19,16 @@
 #include "housetile.h"
 #include "inbox.h"
 #include "iologindata.h"
+#include "iomapserialize.h"
 #include "iomarket.h"
 #include "items.h"
+#include "metrics.h"
 #include "monster.h"
 #include "movement.h"
 #include "npc.h"
 #include "outfit.h"
 #include "party.h"
+#include "playernamecache.h"
 #include "podium.h"
 #include "rewardchest.h"
 #include "scheduler.h"
@@ -172,6 +175,10 @@ void Game::setGameState(GameState_t newState)
 
 void Game::saveGameState()
 {
+	//drop a background snapshot that was not written yet, or wait until the one being written is done
+	++saveGeneration;
+	std::lock_guard<std::mutex> lockClass(backgroundSaveLock);
+
 	if (gameState == GAME_STATE_NORMAL) {
 		setGameState(GAME_STATE_MAINTAIN);
 	}
@@ -198,6 +205,124 @@ void Game::saveGameState()
 	console::print(CONSOLEMESSAGE_TYPE_INFO, "Server save complete!");
 }
 
+struct GameSaveSnapshot {
+	std::vector<std::string> accountStorage;
+	std::vector<PlayerSaveData> players;
+	std::vector<size_t> writtenPlayers;
+	std::vector<std::string> houseInfo;
+	HouseItemsSaveData houseItems;
+};
+
+void Game::saveGameStateInBackground()
+{
+	if (backgroundSaveRunning) {
+		console::reportWarning("Game::saveGameStateInBackground", "The previous server save is still being written, skipping this one.");
+		return;
+	}
+
+	int64_t start = OTSYS_TIME();
+	console::print(CONSOLEMESSAGE_TYPE_INFO, "Saving server in background ... ");
+
+	//the whole snapshot is taken within this one task, splitting it over several ticks
+	//would let an item move from a saved player into a not yet saved house and duplicate it
+	auto snapshot = std::make_shared<GameSaveSnapshot>();
+	buildAccountStorageSave(snapshot->accountStorage);
+
+	//players saved directly (logout) from now on are newer than the snapshot
+	IOLoginData::startSaveTracking();
+
+	size_t storageRows = 0;
+	snapshot->players.reserve(players.size());
+	for (const auto& it : players) {
+		it.second->loginPosition = it.second->getPosition();
+
+		PlayerSaveData data;
+		if (IOLoginData::buildPlayerSave(it.second, data)) {
+			storageRows += data.storages.size();
+			snapshot->players.push_back(std::move(data));
+		} else {
+			console::reportError("Game::saveGameStateInBackground", fmt::format("Failed to capture player {:s}!", it.second->getName()));
+		}
+	}
+
+	IOMapSerialize::buildHouseInfoSave(snapshot->houseInfo);
+	IOMapSerialize::buildHouseItemsSave(snapshot->houseItems);
+
+	console::print(CONSOLEMESSAGE_TYPE_INFO, fmt::format("Captured {:d} players ({:d} changed storages) and {:d} changed houses in {:d} ms.", snapshot->players.size(), storageRows, snapshot->houseItems.tileHashes.size(), OTSYS_TIME() - start));
+
+	backgroundSaveRunning = true;
+	uint32_t generation = saveGeneration;
+	bool queued = g_databaseTasks.addJob([this, snapshot, generation, start](Database& db) {
+		//checked before locking too: a save that flushes this job runs it while holding the lock
+		std::unique_lock<std::mutex> lockClass(backgroundSaveLock, std::defer_lock);
+		if (generation == saveGeneration) {
+			lockClass.lock();
+		}
+
+		if (generation != saveGeneration) {
+			g_dispatcher.addTask(createTask([this]() {
+				IOLoginData::stopSaveTracking();
+				backgroundSaveRunning = false;
+			}));
+			return;
+		}
+
+		bool success = true;
+		if (!db.executeTransaction(snapshot->accountStorage)) {
+			console::reportError("Game::saveGameStateInBackground", "Failed to save account storages!");
+			success = false;
+		}
+
+		for (size_t i = 0; i < snapshot->players.size(); ++i) {
+			const PlayerSaveData& data = snapshot->players[i];
+
+			bool written;
+			if (!IOLoginData::writePlayerSave(db, data, written, true)) {
+				console::reportError("Game::saveGameStateInBackground", fmt::format("Failed to save player {:d}!", data.guid));
+				success = false;
+			} else if (written) {
+				snapshot->writtenPlayers.push_back(i);
+			}
+		}
+
+		bool housesSaved = false;
+		for (uint32_t tries = 0; tries < 3 && !housesSaved; tries++) {
+			housesSaved = db.executeTransaction(snapshot->houseInfo) && (snapshot->houseItems.queries.empty() || db.executeTransaction(snapshot->houseItems.queries));
+		}
+
+		if (!housesSaved) {
+			console::reportError("Game::saveGameStateInBackground", "Failed to save houses!");
+			success = false;
+		}
+
+		g_dispatcher.addTask(createTask(([this, snapshot, housesSaved, success, start]() {
+			if (housesSaved) {
+				IOMapSerialize::applyHouseItemsSave(snapshot->houseItems);
+			}
+
+			for (size_t i : snapshot->writtenPlayers) {
+				const PlayerSaveData& data = snapshot->players[i];
+				if (Player* player = getPlayerByGUID(data.guid)) {
+					player->onStoragesSaved(data.storages);
+				}
+			}
+
+			IOLoginData::stopSaveTracking();
+			backgroundSaveRunning = false;
+
+			if (success) {
+				console::print(CONSOLEMESSAGE_TYPE_INFO, fmt::format("Background server save complete in {:d} ms.", OTSYS_TIME() - start));
+			}
+		})));
+	});
+
+	if (!queued) {
+		IOLoginData::stopSaveTracking();
+		backgroundSaveRunning = false;
+		saveGameState();
+	}
+}
+
 bool Game::loadMainMap(const std::string& filename)
 {
 	return map.loadMap("data/world/" + filename + ".otbm", true);
@@ -4301,6 +4426,10 @@ void Game::removeCreatureCheck(Creature* creature)
 
 void Game::checkCreatures(size_t index)
 {
+	static metrics::Histogram& tickDuration = metrics::Registry::getInstance().histogram("tfs_game_tick_duration_seconds", "Time spent in one creature check round");
+	static metrics::Gauge& playersOnlineGauge = metrics::Registry::getInstance().gauge("tfs_players_online", "Players online");
+	metrics::ScopedTimer timer(tickDuration);
+
 	g_scheduler.addEvent(createSchedulerTask(EVENT_CHECK_CREATURE_INTERVAL, [=]() { checkCreatures((index + 1) % EVENT_CREATURECOUNT); }));
 
 	auto& checkCreatureList = checkCreatureLists[index];
@@ -4323,6 +4452,7 @@ void Game::checkCreatures(size_t index)
 
 	cleanup();
 	g_stats.playersOnline = getPlayersOnline();
+	playersOnlineGauge.set(getPlayersOnline());
 }
 
 void Game::changeSpeed(Creature* creature, int32_t varSpeedDelta)
@@ -5285,35 +5415,26 @@ bool Game::saveAccountStorageKey(uint32_t accountId, uint32_t key) const
 
 bool Game::saveAccountStorageValues() const
 {
-	DBTransaction transaction;
-	Database& db = Database::getInstance();
-
-	if (!transaction.begin()) {
-		return false;
-	}
+	std::vector<std::string> queries;
+	buildAccountStorageSave(queries);
+	return Database::getInstance().executeTransaction(queries);
+}
 
-	if (!db.executeQuery("DELETE FROM `account_storage`")) {
-		return false;
-	}
+void Game::buildAccountStorageSave(std::vector<std::string>& queries) const
+{
+	queries.emplace_back("DELETE FROM `account_storage`");
 
-	for (const auto& accountIt : g_game.accountStorageMap) {
+	for (const auto& accountIt : accountStorageMap) {
 		if (accountIt.second.empty()) {
 			continue;
 		}
 
-		DBInsert accountStorageQuery("INSERT INTO `account_storage` (`account_id`, `key`, `value`) VALUES");
+		DBInsert accountStorageQuery("INSERT INTO `account_storage` (`account_id`, `key`, `value`) VALUES", queries);
 		for (const auto& storageIt : accountIt.second) {
-			if (!accountStorageQuery.addRow(fmt::format("{:d}, {:d}, {:d}", accountIt.first, storageIt.first, storageIt.second))) {
-				return false;
-			}
-		}
-
-		if (!accountStorageQuery.execute()) {
-			return false;
+			accountStorageQuery.addRow(fmt::format("{:d}, {:d}, {:d}", accountIt.first, storageIt.first, storageIt.second));
 		}
+		accountStorageQuery.execute();
 	}
-
-	return transaction.commit();
 }
 
 void Game::internalDecayItem(Item* item)
@@ -5419,6 +5540,7 @@ void Game::shutdown()
 	g_databaseTasks.shutdown();
 	g_dispatcher.shutdown();
 	g_stats.shutdown();
+	g_metricsServer.shutdown();
 	map.spawns.clear();
 	raids.clear();
 
@@ -6805,6 +6927,7 @@ void Game::renamePlayer(Player* player, const std::string& newName)
 
 	// set new name
 	player->setName(newName);
+	PlayerNameCache::getInstance().rename(player->getGUID(), newName);
 
 	// reference new name
 	const std::string& lowercase_new = asLowerCaseString(newName);
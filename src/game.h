@@ -474,6 +474,7 @@ class Game
 		GameState_t getGameState() const;
 		void setGameState(GameState_t newState);
 		void saveGameState();
+		void saveGameStateInBackground();
 
 		//Events
 		void checkCreatureWalk(uint32_t creatureId);
@@ -502,6 +503,7 @@ class Game
 		int32_t getAccountStorageValue(const uint32_t accountId, const uint32_t key) const;
 		void loadAccountStorageValues();
 		bool saveAccountStorageValues() const;
+		void buildAccountStorageSave(std::vector<std::string>& queries) const;
 		bool saveAccountStorageKey(uint32_t accountId, uint32_t key) const;
 
 		void startDecay(Item* item);
@@ -661,6 +663,12 @@ class Game
 		GameState_t gameState = GAME_STATE_NORMAL;
 		WorldType_t worldType = WORLD_TYPE_PVP;
 
+		//held by the database thread while it writes a background save,
+		//a newer generation makes a snapshot that has not been written yet obsolete
+		std::mutex backgroundSaveLock;
+		std::atomic<uint32_t> saveGeneration {0};
+		bool backgroundSaveRunning = false;
+
 		ServiceManager* serviceManager = nullptr;
 
 		void updatePlayersRecord() const;
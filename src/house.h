@@ -213,6 +213,14 @@ class House
 			return static_cast<uint32_t>(std::ceil(bedsList.size() / 2.)); //each bed takes 2 sqms of space, ceil is just for bad maps
 		}
 
+		//hash of the tile data last written to tile_store, 0 if not written yet
+		uint64_t getTileStoreHash() const {
+			return tileStoreHash;
+		}
+		void setTileStoreHash(uint64_t hash) {
+			tileStoreHash = hash;
+		}
+
 	private:
 		bool transferToDepot() const;
 		bool transferToDepot(Player* player) const;
@@ -233,6 +241,8 @@ class House
 
 		time_t paidUntil = 0;
 
+		uint64_t tileStoreHash = 0;
+
 		uint32_t id;
 		uint32_t owner = 0;
 		uint32_t ownerAccountId = 0;
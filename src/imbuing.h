@@ -230,7 +230,11 @@ class Imbuement {
 		void update(bool consumeDuration) {
 			int64_t now = OTSYS_TIME();
 			if (consumeDuration) {
-				this->duration = duration - static_cast<int32_t>((now - lastUpdated)/1000);
+				// only whole seconds are consumed, the rest carries over to the next update
+				const int64_t seconds = (now - lastUpdated) / 1000;
+				this->duration = duration - static_cast<int32_t>(seconds);
+				this->lastUpdated += seconds * 1000;
+				return;
 			}
 			this->lastUpdated = now;
 		}
@@ -0,0 +1,137 @@
+// Copyright 2022 The Forgotten Server Authors. All rights reserved.
+// Use of this source code is governed by the GPL-2.0 License that can be found in the LICENSE file.
+
+#include "otpch.h"
+
+#include "inputqueue.h"
+
+#include "configmanager.h"
+#include "metrics.h"
+#include "tasks.h"
+
+extern ConfigManager g_config;
+extern Dispatcher g_dispatcher;
+
+namespace {
+
+constexpr uint8_t NO_GROUP = 0;
+
+// actions of the same group replace each other while pending
+uint8_t getCoalesceGroup(uint8_t opcode)
+{
+	switch (opcode) {
+		case 0x1D: // ping back
+		case 0x1E: // ping
+		case 0x64: // auto walk
+		case 0x8C: // look at, per position and stackpos
+		case 0x8D: // look in battle list, per creature
+		case 0xA0: // fight modes
+		case 0xA1: // attack
+		case 0xA2: // follow
+		case 0xCA: // update container, per container id
+			return opcode;
+
+		case 0x6F:
+		case 0x70:
+		case 0x71:
+		case 0x72: // turn
+			return 0x6F;
+
+		default:
+			return NO_GROUP;
+	}
+}
+
+class OpcodeCounters
+{
+	public:
+		OpcodeCounters(const char* name, const char* help) : name(name), help(help) {}
+
+		void increment(uint8_t opcode) {
+			metrics::Counter* counter = counters[opcode].load(std::memory_order_acquire);
+			if (!counter) {
+				//the registry hands out the same counter to every caller
+				counter = &metrics::Registry::getInstance().counter(name, help, fmt::format("opcode=\"0x{:02X}\"", opcode));
+				counters[opcode].store(counter, std::memory_order_release);
+			}
+			counter->increment();
+		}
+
+	private:
+		const char* name;
+		const char* help;
+		std::array<std::atomic<metrics::Counter*>, 256> counters = {};
+};
+
+OpcodeCounters actionsTotal("tfs_input_actions_total", "Player actions received per client opcode");
+OpcodeCounters coalescedTotal("tfs_input_coalesced_total", "Pending player actions replaced by a newer one");
+OpcodeCounters droppedTotal("tfs_input_dropped_total", "Player actions dropped over their budget");
+metrics::Counter& drainTasks = metrics::Registry::getInstance().counter("tfs_input_drain_tasks_total", "Dispatcher tasks that ran queued player actions");
+
+}
+
+InputQueue::~InputQueue()
+{
+	for (const Entry& entry : entries) {
+		delete entry.task;
+	}
+}
+
+bool InputQueue::push(uint8_t opcode, uint64_t key, Task* task)
+{
+	actionsTotal.increment(opcode);
+	const uint8_t group = getCoalesceGroup(opcode);
+
+	std::lock_guard<std::mutex> lockClass(queueLock);
+	if (group != NO_GROUP) {
+		auto it = std::find_if(entries.begin(), entries.end(), [group, key](const Entry& entry) {
+			return entry.group == group && entry.key == key;
+		});
+		if (it != entries.end()) {
+			//the newer action goes last so it keeps its place relative to the others
+			coalescedTotal.increment(it->opcode);
+			--pending[it->opcode];
+			delete it->task;
+			entries.erase(it);
+		}
+	}
+
+	const uint16_t budget = g_config.getInputBudget(opcode);
+	const auto maxSize = static_cast<size_t>(std::max<int32_t>(1, g_config.getNumber(ConfigManager::INPUT_QUEUE_SIZE)));
+	if ((budget != 0 && pending[opcode] >= budget) || entries.size() >= maxSize) {
+		droppedTotal.increment(opcode);
+		delete task;
+		return false;
+	}
+
+	++pending[opcode];
+	entries.push_back({task, key, opcode, group});
+
+	if (scheduled) {
+		return false;
+	}
+
+	scheduled = true;
+	return true;
+}
+
+void InputQueue::drain()
+{
+	{
+		std::lock_guard<std::mutex> lockClass(queueLock);
+		running.swap(entries);
+		pending.fill(0);
+		scheduled = false;
+	}
+
+	drainTasks.increment();
+	for (const Entry& entry : running) {
+		if (!entry.task->hasExpired()) {
+			(*entry.task)();
+		} else {
+			g_dispatcher.addExpiredTask();
+		}
+		delete entry.task;
+	}
+	running.clear();
+}
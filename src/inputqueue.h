@@ -0,0 +1,47 @@
+// Copyright 2022 The Forgotten Server Authors. All rights reserved.
+// Use of this source code is governed by the GPL-2.0 License that can be found in the LICENSE file.
+
+#ifndef FS_INPUTQUEUE_H
+#define FS_INPUTQUEUE_H
+
+class Task;
+
+/*
+ * actions one player sent that wait for the dispatcher: instead of a
+ * dispatcher task per packet they all run in one task per player per cycle.
+ * An action superseded by a newer one of the same kind (a new walk path, turn,
+ * look or refresh of the same container) is dropped, and every client opcode
+ * can only have a configured number of actions pending
+ */
+class InputQueue
+{
+	public:
+		InputQueue() = default;
+		~InputQueue();
+
+		// non-copyable
+		InputQueue(const InputQueue&) = delete;
+		InputQueue& operator=(const InputQueue&) = delete;
+
+		// takes ownership of the task, returns true when a drain has to be scheduled
+		bool push(uint8_t opcode, uint64_t key, Task* task);
+
+		// runs everything pushed so far, dispatcher thread only
+		void drain();
+
+	private:
+		struct Entry {
+			Task* task;
+			uint64_t key;
+			uint8_t opcode;
+			uint8_t group;
+		};
+
+		std::mutex queueLock;
+		std::vector<Entry> entries;
+		std::vector<Entry> running;
+		std::array<uint16_t, 256> pending = {};
+		bool scheduled = false;
+};
+
+#endif
@@ -10,11 +10,77 @@
 #include "depotchest.h"
 #include "game.h"
 #include "inbox.h"
+#include "playernamecache.h"
 #include "storeinbox.h"
 
 extern ConfigManager g_config;
 extern Game g_game;
 
+std::mutex IOLoginData::saveTrackingLock;
+std::unordered_set<uint32_t> IOLoginData::playersSavedSinceSnapshot;
+bool IOLoginData::saveTracking = false;
+
+namespace {
+
+PlayerNameEntry readPlayerNameEntry(const DBResult_ptr& result)
+{
+	PlayerNameEntry entry;
+	entry.guid = result->getNumber<uint32_t>("id");
+	entry.name = result->getString("name");
+	entry.accountId = result->getNumber<uint32_t>("account_id");
+	entry.groupId = result->getNumber<uint16_t>("group_id");
+	return entry;
+}
+
+bool findPlayerByName(const std::string& name, PlayerNameEntry& entry)
+{
+	PlayerNameCache& cache = PlayerNameCache::getInstance();
+	switch (cache.getByName(name, entry)) {
+		case PlayerNameCache::LOOKUP_FOUND:
+			return true;
+		case PlayerNameCache::LOOKUP_MISSING:
+			return false;
+		default:
+			break;
+	}
+
+	Database& db = Database::getInstance();
+	DBResult_ptr result = db.storeQuery(fmt::format("SELECT `id`, `name`, `account_id`, `group_id` FROM `players` WHERE `name` = {:s}", db.escapeString(name)));
+	if (!result) {
+		cache.insertMissing(name);
+		return false;
+	}
+
+	entry = readPlayerNameEntry(result);
+	cache.insert(entry);
+	return true;
+}
+
+bool findPlayerByGuid(uint32_t guid, PlayerNameEntry& entry)
+{
+	PlayerNameCache& cache = PlayerNameCache::getInstance();
+	switch (cache.getByGuid(guid, entry)) {
+		case PlayerNameCache::LOOKUP_FOUND:
+			return true;
+		case PlayerNameCache::LOOKUP_MISSING:
+			return false;
+		default:
+			break;
+	}
+
+	DBResult_ptr result = Database::getInstance().storeQuery(fmt::format("SELECT `id`, `name`, `account_id`, `group_id` FROM `players` WHERE `id` = {:d}", guid));
+	if (!result) {
+		cache.insertMissing(guid);
+		return false;
+	}
+
+	entry = readPlayerNameEntry(result);
+	cache.insert(entry);
+	return true;
+}
+
+}
+
 Account IOLoginData::loadAccount(uint32_t accno)
 {
 	Account account;
@@ -128,13 +194,11 @@ uint32_t IOLoginData::gameworldAuthentication(const std::string& accountName, co
 
 uint32_t IOLoginData::getAccountIdByPlayerName(const std::string& playerName)
 {
-	Database& db = Database::getInstance();
-
-	DBResult_ptr result = db.storeQuery(fmt::format("SELECT `account_id` FROM `players` WHERE `name` = {:s}", db.escapeString(playerName)));
-	if (!result) {
+	PlayerNameEntry entry;
+	if (!findPlayerByName(playerName, entry)) {
 		return 0;
 	}
-	return result->getNumber<uint32_t>("account_id");
+	return entry.accountId;
 }
 
 uint32_t IOLoginData::getAccountIdByPlayerId(uint32_t playerId)
@@ -213,19 +277,74 @@ bool IOLoginData::preloadPlayer(Player* player, const std::string& name)
 
 bool IOLoginData::loadPlayerById(Player* player, uint32_t id)
 {
-	Database& db = Database::getInstance();
-	return loadPlayer(player, db.storeQuery(fmt::format("SELECT `id`, `name`, `account_id`, `group_id`, `sex`, `vocation`, `experience`, `level`, `maglevel`, `health`, `healthmax`, `blessings`, `mana`, `manamax`, `manaspent`, `soul`, `lookbody`, `lookfeet`, `lookhead`, `looklegs`, `looktype`, `lookaddons`, `lookmount`, `lookmounthead`, `lookmountbody`, `lookmountlegs`, `lookmountfeet`, `posx`, `posy`, `posz`, `cap`, `lastlogin`, `lastlogout`, `lastip`, `conditions`, `skulltime`, `skull`, `town_id`, `balance`, `offlinetraining_time`, `offlinetraining_skill`, `stamina`, `skill_fist`, `skill_fist_tries`, `skill_club`, `skill_club_tries`, `skill_sword`, `skill_sword_tries`, `skill_axe`, `skill_axe_tries`, `skill_dist`, `skill_dist_tries`, `skill_shielding`, `skill_shielding_tries`, `skill_fishing`, `skill_fishing_tries`, `direction` FROM `players` WHERE `id` = {:d}", id)));
+	PlayerLoadData data;
+	if (!fetchPlayerById(Database::getInstance(), id, data)) {
+		return false;
+	}
+	return loadPlayer(player, data);
 }
 
 bool IOLoginData::loadPlayerByName(Player* player, const std::string& name)
 {
-	Database& db = Database::getInstance();
-	return loadPlayer(player, db.storeQuery(fmt::format("SELECT `id`, `name`, `account_id`, `group_id`, `sex`, `vocation`, `experience`, `level`, `maglevel`, `health`, `healthmax`, `blessings`, `mana`, `manamax`, `manaspent`, `soul`, `lookbody`, `lookfeet`, `lookhead`, `looklegs`, `looktype`, `lookaddons`, `lookmount`, `lookmounthead`, `lookmountbody`, `lookmountlegs`, `lookmountfeet`, `posx`, `posy`, `posz`, `cap`, `lastlogin`, `lastlogout`, `lastip`, `conditions`, `skulltime`, `skull`, `town_id`, `balance`, `offlinetraining_time`, `offlinetraining_skill`, `stamina`, `skill_fist`, `skill_fist_tries`, `skill_club`, `skill_club_tries`, `skill_sword`, `skill_sword_tries`, `skill_axe`, `skill_axe_tries`, `skill_dist`, `skill_dist_tries`, `skill_shielding`, `skill_shielding_tries`, `skill_fishing`, `skill_fishing_tries`, `direction` FROM `players` WHERE `name` = {:s}", db.escapeString(name))));
+	PlayerLoadData data;
+	if (!fetchPlayerByName(Database::getInstance(), name, data)) {
+		return false;
+	}
+	return loadPlayer(player, data);
 }
 
-static GuildWarVector getWarList(uint32_t guildId)
+bool IOLoginData::fetchPlayerById(Database& db, uint32_t id, PlayerLoadData& data)
+{
+	data.player = db.storeQuery(fmt::format("SELECT `id`, `name`, `account_id`, `group_id`, `sex`, `vocation`, `experience`, `level`, `maglevel`, `health`, `healthmax`, `blessings`, `mana`, `manamax`, `manaspent`, `soul`, `lookbody`, `lookfeet`, `lookhead`, `looklegs`, `looktype`, `lookaddons`, `lookmount`, `lookmounthead`, `lookmountbody`, `lookmountlegs`, `lookmountfeet`, `posx`, `posy`, `posz`, `cap`, `lastlogin`, `lastlogout`, `lastip`, `conditions`, `skulltime`, `skull`, `town_id`, `balance`, `offlinetraining_time`, `offlinetraining_skill`, `stamina`, `skill_fist`, `skill_fist_tries`, `skill_club`, `skill_club_tries`, `skill_sword`, `skill_sword_tries`, `skill_axe`, `skill_axe_tries`, `skill_dist`, `skill_dist_tries`, `skill_shielding`, `skill_shielding_tries`, `skill_fishing`, `skill_fishing_tries`, `direction` FROM `players` WHERE `id` = {:d}", id));
+	if (!data.player) {
+		PlayerNameCache::getInstance().remove(id);
+	}
+	return fetchPlayer(db, data);
+}
+
+bool IOLoginData::fetchPlayerByName(Database& db, const std::string& name, PlayerLoadData& data)
+{
+	data.player = db.storeQuery(fmt::format("SELECT `id`, `name`, `account_id`, `group_id`, `sex`, `vocation`, `experience`, `level`, `maglevel`, `health`, `healthmax`, `blessings`, `mana`, `manamax`, `manaspent`, `soul`, `lookbody`, `lookfeet`, `lookhead`, `looklegs`, `looktype`, `lookaddons`, `lookmount`, `lookmounthead`, `lookmountbody`, `lookmountlegs`, `lookmountfeet`, `posx`, `posy`, `posz`, `cap`, `lastlogin`, `lastlogout`, `lastip`, `conditions`, `skulltime`, `skull`, `town_id`, `balance`, `offlinetraining_time`, `offlinetraining_skill`, `stamina`, `skill_fist`, `skill_fist_tries`, `skill_club`, `skill_club_tries`, `skill_sword`, `skill_sword_tries`, `skill_axe`, `skill_axe_tries`, `skill_dist`, `skill_dist_tries`, `skill_shielding`, `skill_shielding_tries`, `skill_fishing`, `skill_fishing_tries`, `direction` FROM `players` WHERE `name` = {:s}", db.escapeString(name)));
+	if (!data.player) {
+		PlayerNameCache::getInstance().remove(name);
+	}
+	return fetchPlayer(db, data);
+}
+
+bool IOLoginData::fetchPlayer(Database& db, PlayerLoadData& data)
+{
+	if (!data.player) {
+		return false;
+	}
+
+	//the row was just read, correct whatever the cache holds for the player
+	PlayerNameCache::getInstance().insert(readPlayerNameEntry(data.player));
+
+	uint32_t guid = data.player->getNumber<uint32_t>("id");
+	uint32_t accountId = data.player->getNumber<uint32_t>("account_id");
+
+	data.account = db.storeQuery(fmt::format("SELECT `type`, `premium_ends_at` FROM `accounts` WHERE `id` = {:d}", accountId));
+
+	if ((data.guildMembership = db.storeQuery(fmt::format("SELECT `guild_id`, `rank_id`, `nick` FROM `guild_membership` WHERE `player_id` = {:d}", guid)))) {
+		uint32_t guildId = data.guildMembership->getNumber<uint32_t>("guild_id");
+		data.guildRank = db.storeQuery(fmt::format("SELECT `id`, `name`, `level` FROM `guild_ranks` WHERE `id` = {:d}", data.guildMembership->getNumber<uint32_t>("rank_id")));
+		data.guildMemberCount = db.storeQuery(fmt::format("SELECT COUNT(*) AS `members` FROM `guild_membership` WHERE `guild_id` = {:d}", guildId));
+		data.guildWars = db.storeQuery(fmt::format("SELECT `guild1`, `guild2` FROM `guild_wars` WHERE (`guild1` = {:d} OR `guild2` = {:d}) AND `ended` = 0 AND `status` = 1", guildId, guildId));
+	}
+
+	data.spells = db.storeQuery(fmt::format("SELECT `player_id`, `name` FROM `player_spells` WHERE `player_id` = {:d}", guid));
+	data.items = db.storeQuery(fmt::format("SELECT `player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_items` WHERE `player_id` = {:d} ORDER BY `sid` DESC", guid));
+	data.depotItems = db.storeQuery(fmt::format("SELECT `player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_depotitems` WHERE `player_id` = {:d} ORDER BY `sid` DESC", guid));
+	data.inboxItems = db.storeQuery(fmt::format("SELECT `player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_inboxitems` WHERE `player_id` = {:d} ORDER BY `sid` DESC", guid));
+	data.storeInboxItems = db.storeQuery(fmt::format("SELECT `player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_storeinboxitems` WHERE `player_id` = {:d} ORDER BY `sid` DESC", guid));
+	data.rewardChest = db.storeQuery(fmt::format("SELECT `player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_rewardchest` WHERE `player_id` = {:d} ORDER BY `sid` DESC", guid));
+	data.storage = db.storeQuery(fmt::format("SELECT `key`, `value` FROM `player_storage` WHERE `player_id` = {:d}", guid));
+	data.vipList = db.storeQuery(fmt::format("SELECT `player_id` FROM `account_viplist` WHERE `account_id` = {:d}", accountId));
+	return true;
+}
+
+static GuildWarVector getWarList(uint32_t guildId, DBResult_ptr result)
 {
-	DBResult_ptr result = Database::getInstance().storeQuery(fmt::format("SELECT `guild1`, `guild2` FROM `guild_wars` WHERE (`guild1` = {:d} OR `guild2` = {:d}) AND `ended` = 0 AND `status` = 1", guildId, guildId));
 	if (!result) {
 		return {};
 	}
@@ -242,24 +361,26 @@ static GuildWarVector getWarList(uint32_t guildId)
 	return guildWarVector;
 }
 
-bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
+bool IOLoginData::loadPlayer(Player* player, const PlayerLoadData& data)
 {
+	DBResult_ptr result = data.player;
 	if (!result) {
 		return false;
 	}
 
-	Database& db = Database::getInstance();
-
 	uint32_t accno = result->getNumber<uint32_t>("account_id");
-	Account acc = loadAccount(accno);
 
 	player->setGUID(result->getNumber<uint32_t>("id"));
 	player->name = result->getString("name");
 	player->accountNumber = accno;
 
-	player->accountType = acc.accountType;
-
-	player->premiumEndsAt = acc.premiumEndsAt;
+	if (data.account) {
+		player->accountType = static_cast<AccountType_t>(data.account->getNumber<int32_t>("type"));
+		player->premiumEndsAt = data.account->getNumber<time_t>("premium_ends_at");
+	} else {
+		player->accountType = ACCOUNT_TYPE_NORMAL;
+		player->premiumEndsAt = 0;
+	}
 
 	Group* group = g_game.groups.getGroup(result->getNumber<uint16_t>("group_id"));
 	if (!group) {
@@ -399,7 +520,7 @@ bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
 		player->skills[i].percent = Player::getPercentLevel(skillTries, nextSkillTries);
 	}
 
-	if ((result = db.storeQuery(fmt::format("SELECT `guild_id`, `rank_id`, `nick` FROM `guild_membership` WHERE `player_id` = {:d}", player->getGUID())))) {
+	if ((result = data.guildMembership)) {
 		uint32_t guildId = result->getNumber<uint32_t>("guild_id");
 		uint32_t playerRankId = result->getNumber<uint32_t>("rank_id");
 		player->guildNick = result->getString("nick");
@@ -418,7 +539,7 @@ bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
 			player->guild = guild;
 			GuildRank_ptr rank = guild->getRankById(playerRankId);
 			if (!rank) {
-				if ((result = db.storeQuery(fmt::format("SELECT `id`, `name`, `level` FROM `guild_ranks` WHERE `id` = {:d}", playerRankId)))) {
+				if ((result = data.guildRank)) {
 					guild->addRank(result->getNumber<uint32_t>("id"), result->getString("name"), result->getNumber<uint16_t>("level"));
 				}
 
@@ -429,15 +550,15 @@ bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
 			}
 
 			player->guildRank = rank;
-			player->guildWarVector = getWarList(guildId);
+			player->guildWarVector = getWarList(guildId, data.guildWars);
 
-			if ((result = db.storeQuery(fmt::format("SELECT COUNT(*) AS `members` FROM `guild_membership` WHERE `guild_id` = {:d}", guildId)))) {
+			if ((result = data.guildMemberCount)) {
 				guild->setMemberCount(result->getNumber<uint32_t>("members"));
 			}
 		}
 	}
 
-	if ((result = db.storeQuery(fmt::format("SELECT `player_id`, `name` FROM `player_spells` WHERE `player_id` = {:d}", player->getGUID())))) {
+	if ((result = data.spells)) {
 		do {
 			player->learnedInstantSpellList.emplace_front(result->getString("name"));
 		} while (result->next());
@@ -447,7 +568,7 @@ bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
 	ItemMap itemMap;
 	std::map<uint8_t, Container*> openContainersList;
 
-	if ((result = db.storeQuery(fmt::format("SELECT `player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_items` WHERE `player_id` = {:d} ORDER BY `sid` DESC", player->getGUID())))) {
+	if ((result = data.items)) {
 		loadItems(itemMap, result);
 
 		for (ItemMap::const_reverse_iterator it = itemMap.rbegin(), end = itemMap.rend(); it != end; ++it) {
@@ -482,7 +603,7 @@ bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
 	//load depot items
 	itemMap.clear();
 
-	if ((result = db.storeQuery(fmt::format("SELECT `player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_depotitems` WHERE `player_id` = {:d} ORDER BY `sid` DESC", player->getGUID())))) {
+	if ((result = data.depotItems)) {
 		loadItems(itemMap, result);
 
 		for (ItemMap::const_reverse_iterator it = itemMap.rbegin(), end = itemMap.rend(); it != end; ++it) {
@@ -512,7 +633,7 @@ bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
 	//load inbox items
 	itemMap.clear();
 
-	if ((result = db.storeQuery(fmt::format("SELECT `player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_inboxitems` WHERE `player_id` = {:d} ORDER BY `sid` DESC", player->getGUID())))) {
+	if ((result = data.inboxItems)) {
 		loadItems(itemMap, result);
 
 		for (ItemMap::const_reverse_iterator it = itemMap.rbegin(), end = itemMap.rend(); it != end; ++it) {
@@ -540,7 +661,7 @@ bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
 	//load store inbox items
 	itemMap.clear();
 
-	if ((result = db.storeQuery(fmt::format("SELECT `player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_storeinboxitems` WHERE `player_id` = {:d} ORDER BY `sid` DESC", player->getGUID())))) {
+	if ((result = data.storeInboxItems)) {
 		loadItems(itemMap, result);
 
 		for (ItemMap::const_reverse_iterator it = itemMap.rbegin(), end = itemMap.rend(); it != end; ++it) {
@@ -568,7 +689,7 @@ bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
 	//load reward chest
 	itemMap.clear();
 
-	if ((result = db.storeQuery(fmt::format("SELECT `player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_rewardchest` WHERE `player_id` = {:d} ORDER BY `sid` DESC", player->getGUID())))) {
+	if ((result = data.rewardChest)) {
 		loadItems(itemMap, result);
 
 		for (ItemMap::const_reverse_iterator it = itemMap.rbegin(), end = itemMap.rend(); it != end; ++it) {
@@ -601,14 +722,14 @@ bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result)
 	}
 
 	//load storage map
-	if ((result = db.storeQuery(fmt::format("SELECT `key`, `value` FROM `player_storage` WHERE `player_id` = {:d}", player->getGUID())))) {
+	if ((result = data.storage)) {
 		do {
 			player->addStorageValue(result->getNumber<uint32_t>("key"), result->getNumber<int32_t>("value"), true);
 		} while (result->next());
 	}
 
 	//load vip list
-	if ((result = db.storeQuery(fmt::format("SELECT `player_id` FROM `account_viplist` WHERE `account_id` = {:d}", player->getAccount())))) {
+	if ((result = data.vipList)) {
 		do {
 			player->addVIPInternal(result->getNumber<uint32_t>("player_id"));
 		} while (result->next());
@@ -712,24 +833,105 @@ bool IOLoginData::saveItems(const Player* player, const ItemBlockList& itemList,
 
 bool IOLoginData::savePlayer(Player* player)
 {
-	g_game.saveLatestLootContainerId();
-	g_game.saveLatestRewardId();
+	PlayerSaveData data;
+	if (!buildPlayerSave(player, data)) {
+		return false;
+	}
 
-	if (player->getHealth() <= 0) {
-		player->changeHealth(1);
+	if (saveTracking) {
+		std::lock_guard<std::mutex> lockClass(saveTrackingLock);
+		playersSavedSinceSnapshot.insert(data.guid);
 	}
 
-	Database& db = Database::getInstance();
+	bool written = false;
+	if (!writePlayerSave(Database::getInstance(), data, written)) {
+		return false;
+	}
+
+	if (written) {
+		player->onStoragesSaved(data.storages);
+	}
+	return true;
+}
+
+bool IOLoginData::writePlayerSave(Database& db, const PlayerSaveData& data, bool& written, bool skipIfSavedSinceSnapshot/* = false*/)
+{
+	written = false;
 
-	DBResult_ptr result = db.storeQuery(fmt::format("SELECT `save` FROM `players` WHERE `id` = {:d}", player->getGUID()));
+	DBTransaction transaction(db);
+	if (!transaction.begin()) {
+		return false;
+	}
+
+	//locks the row, a newer save of the same player waits until this one is committed
+	DBResult_ptr result = db.storeQuery(fmt::format("SELECT `save` FROM `players` WHERE `id` = {:d} FOR UPDATE", data.guid));
 	if (!result) {
 		return false;
 	}
 
+	if (skipIfSavedSinceSnapshot) {
+		std::lock_guard<std::mutex> lockClass(saveTrackingLock);
+		if (playersSavedSinceSnapshot.find(data.guid) != playersSavedSinceSnapshot.end()) {
+			return transaction.commit();
+		}
+	}
+
 	if (result->getNumber<uint16_t>("save") == 0) {
-		return db.executeQuery(fmt::format("UPDATE `players` SET `lastlogin` = {:d}, `lastip` = {:d} WHERE `id` = {:d}", player->lastLoginSaved, player->lastIP, player->getGUID()));
+		if (!db.executeQuery(data.loginQuery)) {
+			return false;
+		}
+		return transaction.commit();
+	}
+
+	for (const std::string& query : data.queries) {
+		if (!db.executeQuery(query)) {
+			return false;
+		}
+	}
+
+	//End the transaction
+	written = transaction.commit();
+	return written;
+}
+
+void IOLoginData::startSaveTracking()
+{
+	std::lock_guard<std::mutex> lockClass(saveTrackingLock);
+	playersSavedSinceSnapshot.clear();
+	saveTracking = true;
+}
+
+void IOLoginData::stopSaveTracking()
+{
+	std::lock_guard<std::mutex> lockClass(saveTrackingLock);
+	playersSavedSinceSnapshot.clear();
+	saveTracking = false;
+}
+
+bool IOLoginData::buildPlayerSave(Player* player, PlayerSaveData& data)
+{
+	g_game.saveLatestLootContainerId();
+	g_game.saveLatestRewardId();
+
+	if (player->getHealth() <= 0) {
+		player->changeHealth(1);
 	}
 
+	//running imbuements are only consumed when one expires, bring them up to date before the durations are written
+	if (!player->isOffline()) {
+		player->consumeImbuements(true, player->getZone() != ZONE_PROTECTION && player->hasCondition(CONDITION_INFIGHT));
+		player->scheduleImbuementUpdate();
+	}
+
+	Database& db = Database::getInstance();
+
+	data.guid = player->getGUID();
+	PlayerNameCache::getInstance().insert({player->getGUID(), player->getAccount(), player->group->id, player->getName()});
+
+	data.loginQuery = fmt::format("UPDATE `players` SET `lastlogin` = {:d}, `lastip` = {:d} WHERE `id` = {:d}", player->lastLoginSaved, player->lastIP, player->getGUID());
+
+	std::vector<std::string>& queries = data.queries;
+
 	//serialize conditions
 	PropWriteStream propWriteStream;
 	for (Condition* condition : player->conditions) {
@@ -833,21 +1035,12 @@ bool IOLoginData::savePlayer(Player* player)
 	query << "`blessings` = " << player->blessings.to_ulong();
 	query << " WHERE `id` = " << player->getGUID();
 
-	DBTransaction transaction;
-	if (!transaction.begin()) {
-		return false;
-	}
-
-	if (!db.executeQuery(query.str())) {
-		return false;
-	}
+	queries.push_back(query.str());
 
 	// learned spells
-	if (!db.executeQuery(fmt::format("DELETE FROM `player_spells` WHERE `player_id` = {:d}", player->getGUID()))) {
-		return false;
-	}
+	queries.push_back(fmt::format("DELETE FROM `player_spells` WHERE `player_id` = {:d}", player->getGUID()));
 
-	DBInsert spellsQuery("INSERT INTO `player_spells` (`player_id`, `name` ) VALUES ");
+	DBInsert spellsQuery("INSERT INTO `player_spells` (`player_id`, `name` ) VALUES ", queries);
 	for (const std::string& spellName : player->learnedInstantSpellList) {
 		if (!spellsQuery.addRow(fmt::format("{:d}, {:s}", player->getGUID(), db.escapeString(spellName)))) {
 			return false;
@@ -859,11 +1052,9 @@ bool IOLoginData::savePlayer(Player* player)
 	}
 
 	//item saving
-	if (!db.executeQuery(fmt::format("DELETE FROM `player_items` WHERE `player_id` = {:d}", player->getGUID()))) {
-		return false;
-	}
+	queries.push_back(fmt::format("DELETE FROM `player_items` WHERE `player_id` = {:d}", player->getGUID()));
 
-	DBInsert itemsQuery("INSERT INTO `player_items` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ");
+	DBInsert itemsQuery("INSERT INTO `player_items` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ", queries);
 
 	ItemBlockList itemList;
 	for (int32_t slotId = CONST_SLOT_FIRST; slotId <= CONST_SLOT_LAST; ++slotId) {
@@ -878,11 +1069,9 @@ bool IOLoginData::savePlayer(Player* player)
 	}
 
 	//save depot items
-	if (!db.executeQuery(fmt::format("DELETE FROM `player_depotitems` WHERE `player_id` = {:d}", player->getGUID()))) {
-		return false;
-	}
+	queries.push_back(fmt::format("DELETE FROM `player_depotitems` WHERE `player_id` = {:d}", player->getGUID()));
 
-	DBInsert depotQuery("INSERT INTO `player_depotitems` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ");
+	DBInsert depotQuery("INSERT INTO `player_depotitems` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ", queries);
 	itemList.clear();
 
 	for (const auto& it : player->depotChests) {
@@ -896,11 +1085,9 @@ bool IOLoginData::savePlayer(Player* player)
 	}
 
 	//save inbox items
-	if (!db.executeQuery(fmt::format("DELETE FROM `player_inboxitems` WHERE `player_id` = {:d}", player->getGUID()))) {
-		return false;
-	}
+	queries.push_back(fmt::format("DELETE FROM `player_inboxitems` WHERE `player_id` = {:d}", player->getGUID()));
 
-	DBInsert inboxQuery("INSERT INTO `player_inboxitems` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ");
+	DBInsert inboxQuery("INSERT INTO `player_inboxitems` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ", queries);
 	itemList.clear();
 
 	for (Item* item : player->getInbox()->getItemList()) {
@@ -912,11 +1099,9 @@ bool IOLoginData::savePlayer(Player* player)
 	}
 
 	//save reward chest items
-	if (!db.executeQuery(fmt::format("DELETE FROM `player_rewardchest` WHERE `player_id` = {:d}", player->getGUID()))) {
-		return false;
-	}
+	queries.push_back(fmt::format("DELETE FROM `player_rewardchest` WHERE `player_id` = {:d}", player->getGUID()));
 
-	DBInsert rewardChestQuery("INSERT INTO `player_rewardchest` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ");
+	DBInsert rewardChestQuery("INSERT INTO `player_rewardchest` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ", queries);
 	itemList.clear();
 
 	RewardChest* rewardChest = &player->getRewardChest();
@@ -929,11 +1114,9 @@ bool IOLoginData::savePlayer(Player* player)
 	}
 
 	//save store inbox items
-	if (!db.executeQuery(fmt::format("DELETE FROM `player_storeinboxitems` WHERE `player_id` = {:d}", player->getGUID()))) {
-		return false;
-	}
+	queries.push_back(fmt::format("DELETE FROM `player_storeinboxitems` WHERE `player_id` = {:d}", player->getGUID()));
 
-	DBInsert storeInboxQuery("INSERT INTO `player_storeinboxitems` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ");
+	DBInsert storeInboxQuery("INSERT INTO `player_storeinboxitems` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ", queries);
 	itemList.clear();
 
 	for (Item* item : player->getStoreInbox()->getItemList()) {
@@ -944,59 +1127,60 @@ bool IOLoginData::savePlayer(Player* player)
 		return false;
 	}
 
-	if (!db.executeQuery(fmt::format("DELETE FROM `player_storage` WHERE `player_id` = {:d}", player->getGUID()))) {
-		return false;
-	}
-
-	DBInsert storageQuery("INSERT INTO `player_storage` (`player_id`, `key`, `value`) VALUES ");
+	//only the storages changed since the last save
 	player->genReservedStorageRange();
 
-	for (const auto& it : player->storageMap) {
-		if (!storageQuery.addRow(fmt::format("{:d}, {:d}, {:d}", player->getGUID(), it.first, it.second))) {
-			return false;
+	std::ostringstream removedKeys;
+	DBInsert storageQuery("REPLACE INTO `player_storage` (`player_id`, `key`, `value`) VALUES ", queries);
+	for (uint32_t key : player->dirtyStorageKeys) {
+		int32_t value;
+		if (player->getStorageValue(key, value)) {
+			if (!storageQuery.addRow(fmt::format("{:d}, {:d}, {:d}", player->getGUID(), key, value))) {
+				return false;
+			}
+		} else {
+			if (removedKeys.tellp() != 0) {
+				removedKeys << ',';
+			}
+			removedKeys << key;
 		}
+		data.storages.emplace_back(key, value);
 	}
 
-	if (!storageQuery.execute()) {
-		return false;
+	if (removedKeys.tellp() != 0) {
+		queries.push_back(fmt::format("DELETE FROM `player_storage` WHERE `player_id` = {:d} AND `key` IN ({:s})", player->getGUID(), removedKeys.str()));
 	}
-
-	//End the transaction
-	return transaction.commit();
+	return storageQuery.execute();
 }
 
 std::string IOLoginData::getNameByGuid(uint32_t guid)
 {
-	DBResult_ptr result = Database::getInstance().storeQuery(fmt::format("SELECT `name` FROM `players` WHERE `id` = {:d}", guid));
-	if (!result) {
+	PlayerNameEntry entry;
+	if (!findPlayerByGuid(guid, entry)) {
 		return std::string();
 	}
-	return result->getString("name");
+	return entry.name;
 }
 
 uint32_t IOLoginData::getGuidByName(const std::string& name)
 {
-	Database& db = Database::getInstance();
-
-	DBResult_ptr result = db.storeQuery(fmt::format("SELECT `id` FROM `players` WHERE `name` = {:s}", db.escapeString(name)));
-	if (!result) {
+	PlayerNameEntry entry;
+	if (!findPlayerByName(name, entry)) {
 		return 0;
 	}
-	return result->getNumber<uint32_t>("id");
+	return entry.guid;
 }
 
 bool IOLoginData::getGuidByNameEx(uint32_t& guid, bool& specialVip, std::string& name)
 {
-	Database& db = Database::getInstance();
-
-	DBResult_ptr result = db.storeQuery(fmt::format("SELECT `name`, `id`, `group_id`, `account_id` FROM `players` WHERE `name` = {:s}", db.escapeString(name)));
-	if (!result) {
+	PlayerNameEntry entry;
+	if (!findPlayerByName(name, entry)) {
 		return false;
 	}
 
-	name = result->getString("name");
-	guid = result->getNumber<uint32_t>("id");
-	Group* group = g_game.groups.getGroup(result->getNumber<uint16_t>("group_id"));
+	name = entry.name;
+	guid = entry.guid;
+	Group* group = g_game.groups.getGroup(entry.groupId);
 
 	uint64_t flags;
 	if (group) {
@@ -1011,28 +1195,33 @@ bool IOLoginData::getGuidByNameEx(uint32_t& guid, bool& specialVip, std::string&
 
 bool IOLoginData::formatPlayerName(std::string& name)
 {
-	Database& db = Database::getInstance();
-
-	DBResult_ptr result = db.storeQuery(fmt::format("SELECT `name` FROM `players` WHERE `name` = {:s}", db.escapeString(name)));
-	if (!result) {
+	PlayerNameEntry entry;
+	if (!findPlayerByName(name, entry)) {
 		return false;
 	}
 
-	name = result->getString("name");
+	name = entry.name;
 	return true;
 }
 
 void IOLoginData::loadItems(ItemMap& itemMap, DBResult_ptr result)
 {
+	const size_t playerIdColumn = result->getColumnIndex("player_id");
+	const size_t sidColumn = result->getColumnIndex("sid");
+	const size_t pidColumn = result->getColumnIndex("pid");
+	const size_t typeColumn = result->getColumnIndex("itemtype");
+	const size_t countColumn = result->getColumnIndex("count");
+	const size_t attributesColumn = result->getColumnIndex("attributes");
+
 	do {
-		uint32_t player_id = result->getNumber<uint32_t>("player_id");
-		uint32_t sid = result->getNumber<uint32_t>("sid");
-		uint32_t pid = result->getNumber<uint32_t>("pid");
-		uint16_t type = result->getNumber<uint16_t>("itemtype");
-		uint16_t count = result->getNumber<uint16_t>("count");
+		uint32_t player_id = result->getNumber<uint32_t>(playerIdColumn);
+		uint32_t sid = result->getNumber<uint32_t>(sidColumn);
+		uint32_t pid = result->getNumber<uint32_t>(pidColumn);
+		uint16_t type = result->getNumber<uint16_t>(typeColumn);
+		uint16_t count = result->getNumber<uint16_t>(countColumn);
 
 		unsigned long attrSize;
-		const char* attr = result->getStream("attributes", attrSize);
+		const char* attr = result->getStream(attributesColumn, attrSize);
 
 		PropStream propStream;
 		propStream.init(attr, attrSize);
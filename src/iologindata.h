@@ -14,6 +14,33 @@ struct VIPEntry;
 
 using ItemBlockList = std::list<std::pair<int32_t, Item*>>;
 
+// every row a player is built from, fetched up front so the queries can run off the dispatcher
+struct PlayerLoadData {
+	DBResult_ptr player;
+	DBResult_ptr account;
+	DBResult_ptr guildMembership;
+	DBResult_ptr guildRank;
+	DBResult_ptr guildMemberCount;
+	DBResult_ptr guildWars;
+	DBResult_ptr spells;
+	DBResult_ptr items;
+	DBResult_ptr depotItems;
+	DBResult_ptr inboxItems;
+	DBResult_ptr storeInboxItems;
+	DBResult_ptr rewardChest;
+	DBResult_ptr storage;
+	DBResult_ptr vipList;
+};
+
+// every statement of a player save, built on the dispatcher and executed wherever
+struct PlayerSaveData {
+	uint32_t guid = 0;
+	std::string loginQuery;
+	std::vector<std::string> queries;
+	// storages written by the queries, -1 for removed ones
+	std::vector<std::pair<uint32_t, int32_t>> storages;
+};
+
 class IOLoginData
 {
 	public:
@@ -33,8 +60,18 @@ class IOLoginData
 
 		static bool loadPlayerById(Player* player, uint32_t id);
 		static bool loadPlayerByName(Player* player, const std::string& name);
-		static bool loadPlayer(Player* player, DBResult_ptr result);
+		static bool loadPlayer(Player* player, const PlayerLoadData& data);
+
+		// only touches the given connection, safe to call from the database thread
+		static bool fetchPlayerById(Database& db, uint32_t id, PlayerLoadData& data);
+		static bool fetchPlayerByName(Database& db, const std::string& name, PlayerLoadData& data);
 		static bool savePlayer(Player* player);
+		static bool buildPlayerSave(Player* player, PlayerSaveData& data);
+		static bool writePlayerSave(Database& db, const PlayerSaveData& data, bool& written, bool skipIfSavedSinceSnapshot = false);
+
+		// while a background save runs, remembers players saved directly so the older snapshot does not overwrite them
+		static void startSaveTracking();
+		static void stopSaveTracking();
 		static uint32_t getGuidByName(const std::string& name);
 		static bool getGuidByNameEx(uint32_t& guid, bool& specialVip, std::string& name);
 		static std::string getNameByGuid(uint32_t guid);
@@ -52,8 +89,13 @@ class IOLoginData
 	private:
 		using ItemMap = std::map<uint32_t, std::pair<Item*, uint32_t>>;
 
+		static bool fetchPlayer(Database& db, PlayerLoadData& data);
 		static void loadItems(ItemMap& itemMap, DBResult_ptr result);
 		static bool saveItems(const Player* player, const ItemBlockList& itemList, DBInsert& query_insert, PropWriteStream& propWriteStream);
+
+		static std::mutex saveTrackingLock;
+		static std::unordered_set<uint32_t> playersSavedSinceSnapshot;
+		static bool saveTracking;
 };
 
 #endif
@@ -146,6 +146,9 @@ bool IOMap::loadMap(Map* map, const std::string& fileName)
 		return false;
 	}
 
+	if (itemCount != 0) {
+		console::printWorldInfo("Map items", fmt::format("{:d} ({:d} KB, {:.1f} bytes per item)", itemCount, itemMemoryUsage / 1024, static_cast<double>(itemMemoryUsage) / itemCount), isStartup);
+	}
 	console::printWorldInfo("Loaded in", fmt::format("{} seconds", (OTSYS_TIME() - start) / (1000.)), isStartup);
 	return true;
 }
@@ -394,6 +397,18 @@ bool IOMap::parseTileArea(OTB::Loader& loader, const OTB::Node& tileAreaNode, Ma
 
 		tile->setFlag(static_cast<tileflags_t>(tileflags));
 
+		if (const Item* ground = tile->getGround()) {
+			++itemCount;
+			itemMemoryUsage += ground->getMemoryUsage();
+		}
+
+		if (const TileItemVector* items = tile->getItemList()) {
+			for (const Item* item : *items) {
+				++itemCount;
+				itemMemoryUsage += item->getMemoryUsage();
+			}
+		}
+
 		map.setTile(x, y, z, tile);
 	}
 	return true;
@@ -138,6 +138,8 @@ class IOMap
 		bool parseTowns(OTB::Loader& loader, const OTB::Node& townsNode, Map& map);
 		bool parseTileArea(OTB::Loader& loader, const OTB::Node& tileAreaNode, Map& map);
 		std::string errorString;
+		uint64_t itemCount = 0;
+		uint64_t itemMemoryUsage = 0;
 };
 
 #endif
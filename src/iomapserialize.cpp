@@ -12,6 +12,8 @@
 
 extern Game g_game;
 
+bool IOMapSerialize::tileStoreWritten = false;
+
 void IOMapSerialize::loadHouseItems(Map* map)
 {
 	//int64_t start = OTSYS_TIME();
@@ -59,48 +61,102 @@ void IOMapSerialize::loadHouseItems(Map* map)
 
 bool IOMapSerialize::saveHouseItems()
 {
-	//int64_t start = OTSYS_TIME();
-	Database& db = Database::getInstance();
+	int64_t start = OTSYS_TIME();
 
-	//Start the transaction
-	DBTransaction transaction;
-	if (!transaction.begin()) {
-		return false;
+	HouseItemsSaveData data;
+	buildHouseItemsSave(data);
+	if (data.queries.empty()) {
+		return true;
 	}
 
-	//clear old tile data
-	if (!db.executeQuery("DELETE FROM `tile_store`")) {
+	if (!Database::getInstance().executeTransaction(data.queries)) {
 		return false;
 	}
 
-	DBInsert stmt("INSERT INTO `tile_store` (`house_id`, `data`) VALUES ");
+	applyHouseItemsSave(data);
 
-	PropWriteStream stream;
+	console::print(CONSOLEMESSAGE_TYPE_INFO, fmt::format("Saved items of {:d}/{:d} houses in {:d} ms.", data.tileHashes.size(), g_game.map.houses.getHouses().size(), OTSYS_TIME() - start));
+	return true;
+}
+
+void IOMapSerialize::buildHouseItemsSave(HouseItemsSaveData& data)
+{
+	Database& db = Database::getInstance();
+
+	//the first save of a run rewrites the whole table, later ones only the houses
+	//whose tiles no longer serialize to what was written last time
+	data.fullRewrite = !tileStoreWritten;
+
+	std::ostringstream houseIds;
+	DBInsert stmt("INSERT INTO `tile_store` (`house_id`, `data`) VALUES ", data.queries);
+	std::vector<std::string> inserts;
 	for (const auto& it : g_game.map.houses.getHouses()) {
-		//save house items
 		House* house = it.second;
-		for (HouseTile* tile : house->getTiles()) {
-			saveTile(stream, tile);
 
-			size_t attributesSize;
-			const char* attributes = stream.getStream(attributesSize);
-			if (attributesSize > 0) {
-				if (!stmt.addRow(fmt::format("{:d}, {:s}", house->getId(), db.escapeBlob(attributes, attributesSize)))) {
-					return false;
-				}
-				stream.clear();
-			}
+		std::vector<std::string> tiles;
+		uint64_t hash = serializeHouseTiles(house, tiles);
+		if (!data.fullRewrite && hash == house->getTileStoreHash()) {
+			continue;
+		}
+
+		if (houseIds.tellp() != 0) {
+			houseIds << ',';
+		}
+		houseIds << house->getId();
+
+		for (const std::string& tile : tiles) {
+			inserts.push_back(fmt::format("{:d}, {:s}", house->getId(), db.escapeBlob(tile.data(), tile.size())));
 		}
+		data.tileHashes.emplace_back(house->getId(), hash);
 	}
 
-	if (!stmt.execute()) {
-		return false;
+	if (!data.fullRewrite && data.tileHashes.empty()) {
+		return;
 	}
 
-	//End the transaction
-	bool success = transaction.commit();
-	//std::cout << "> Saved house items in: " << (OTSYS_TIME() - start) / (1000.) << " s" << std::endl;
-	return success;
+	//clear old tile data
+	if (data.fullRewrite) {
+		data.queries.emplace_back("DELETE FROM `tile_store`");
+	} else {
+		data.queries.push_back(fmt::format("DELETE FROM `tile_store` WHERE `house_id` IN ({:s})", houseIds.str()));
+	}
+
+	for (const std::string& row : inserts) {
+		stmt.addRow(row);
+	}
+	stmt.execute();
+}
+
+void IOMapSerialize::applyHouseItemsSave(const HouseItemsSaveData& data)
+{
+	for (const auto& it : data.tileHashes) {
+		House* house = g_game.map.houses.getHouse(it.first);
+		if (house) {
+			house->setTileStoreHash(it.second);
+		}
+	}
+	tileStoreWritten = true;
+}
+
+uint64_t IOMapSerialize::serializeHouseTiles(const House* house, std::vector<std::string>& tiles)
+{
+	uint64_t hash = house->getId();
+
+	PropWriteStream stream;
+	for (HouseTile* tile : house->getTiles()) {
+		saveTile(stream, tile);
+
+		size_t attributesSize;
+		const char* attributes = stream.getStream(attributesSize);
+		if (attributesSize > 0) {
+			hash = (hash * 1099511628211ULL) ^ std::hash<std::string_view>{}(std::string_view(attributes, attributesSize));
+			tiles.emplace_back(attributes, attributesSize);
+			stream.clear();
+		}
+	}
+
+	//0 is reserved for houses that were never written
+	return hash != 0 ? hash : 1;
 }
 
 bool IOMapSerialize::loadContainer(PropStream& propStream, Container* container)
@@ -370,71 +426,56 @@ bool IOMapSerialize::loadHouseInfo()
 
 bool IOMapSerialize::saveHouseInfo()
 {
-	Database& db = Database::getInstance();
+	std::vector<std::string> queries;
+	buildHouseInfoSave(queries);
+	return Database::getInstance().executeTransaction(queries);
+}
 
-	DBTransaction transaction;
-	if (!transaction.begin()) {
-		return false;
-	}
+void IOMapSerialize::buildHouseInfoSave(std::vector<std::string>& queries)
+{
+	Database& db = Database::getInstance();
 
-	if (!db.executeQuery("DELETE FROM `house_lists`")) {
-		return false;
-	}
+	queries.emplace_back("DELETE FROM `house_lists`");
 
 	for (const auto& it : g_game.map.houses.getHouses()) {
 		House* house = it.second;
-		DBResult_ptr result = db.storeQuery(fmt::format("SELECT `id` FROM `houses` WHERE `id` = {:d}", house->getId()));
-		if (result) {
-			db.executeQuery(fmt::format("UPDATE `houses` SET `owner` = {:d}, `paid` = {:d}, `warnings` = {:d}, `name` = {:s}, `town_id` = {:d}, `rent` = {:d}, `size` = {:d}, `beds` = {:d} WHERE `id` = {:d}", house->getOwner(), house->getPaidUntil(), house->getPayRentWarnings(), db.escapeString(house->getName()), house->getTownId(), house->getRent(), house->getTiles().size(), house->getBedCount(), house->getId()));
-		} else {
-			db.executeQuery(fmt::format("INSERT INTO `houses` (`id`, `owner`, `paid`, `warnings`, `name`, `town_id`, `rent`, `size`, `beds`) VALUES ({:d}, {:d}, {:d}, {:d}, {:s}, {:d}, {:d}, {:d}, {:d})", house->getId(), house->getOwner(), house->getPaidUntil(), house->getPayRentWarnings(), db.escapeString(house->getName()), house->getTownId(), house->getRent(), house->getTiles().size(), house->getBedCount()));
-		}
+		queries.push_back(fmt::format("INSERT INTO `houses` (`id`, `owner`, `paid`, `warnings`, `name`, `town_id`, `rent`, `size`, `beds`) VALUES ({:d}, {:d}, {:d}, {:d}, {:s}, {:d}, {:d}, {:d}, {:d}) ON DUPLICATE KEY UPDATE `owner` = VALUES(`owner`), `paid` = VALUES(`paid`), `warnings` = VALUES(`warnings`), `name` = VALUES(`name`), `town_id` = VALUES(`town_id`), `rent` = VALUES(`rent`), `size` = VALUES(`size`), `beds` = VALUES(`beds`)", house->getId(), house->getOwner(), house->getPaidUntil(), house->getPayRentWarnings(), db.escapeString(house->getName()), house->getTownId(), house->getRent(), house->getTiles().size(), house->getBedCount()));
 	}
 
-	DBInsert stmt("INSERT INTO `house_lists` (`house_id` , `listid` , `list`) VALUES ");
+	DBInsert stmt("INSERT INTO `house_lists` (`house_id` , `listid` , `list`) VALUES ", queries);
 
 	for (const auto& it : g_game.map.houses.getHouses()) {
 		House* house = it.second;
 
 		std::string listText;
 		if (house->getAccessList(GUEST_LIST, listText) && !listText.empty()) {
-			if (!stmt.addRow(fmt::format("{:d}, {}, {:s}", house->getId(), GUEST_LIST, db.escapeString(listText)))) {
-				return false;
-			}
-
+			stmt.addRow(fmt::format("{:d}, {}, {:s}", house->getId(), GUEST_LIST, db.escapeString(listText)));
 			listText.clear();
 		}
 
 		if (house->getAccessList(SUBOWNER_LIST, listText) && !listText.empty()) {
-			if (!stmt.addRow(fmt::format("{:d}, {}, {:s}", house->getId(), SUBOWNER_LIST, db.escapeString(listText)))) {
-				return false;
-			}
-
+			stmt.addRow(fmt::format("{:d}, {}, {:s}", house->getId(), SUBOWNER_LIST, db.escapeString(listText)));
 			listText.clear();
 		}
 
 		for (Door* door : house->getDoors()) {
 			if (door->getAccessList(listText) && !listText.empty()) {
-				if (!stmt.addRow(fmt::format("{:d}, {:d}, {:s}", house->getId(), door->getDoorId(), db.escapeString(listText)))) {
-					return false;
-				}
-
+				stmt.addRow(fmt::format("{:d}, {:d}, {:s}", house->getId(), door->getDoorId(), db.escapeString(listText)));
 				listText.clear();
 			}
 		}
 	}
 
-	if (!stmt.execute()) {
-		return false;
-	}
-
-	return transaction.commit();
+	stmt.execute();
 }
 
 bool IOMapSerialize::saveHouse(House* house)
 {
 	Database& db = Database::getInstance();
 
+	std::vector<std::string> tiles;
+	uint64_t hash = serializeHouseTiles(house, tiles);
+
 	//Start the transaction
 	DBTransaction transaction;
 	if (!transaction.begin()) {
@@ -442,25 +483,16 @@ bool IOMapSerialize::saveHouse(House* house)
 	}
 
 	uint32_t houseId = house->getId();
-	
+
 	//clear old tile data
 	if (!db.executeQuery(fmt::format("DELETE FROM `tile_store` WHERE `house_id` = {:d}", houseId))) {
 		return false;
 	}
 
 	DBInsert stmt("INSERT INTO `tile_store` (`house_id`, `data`) VALUES ");
-
-	PropWriteStream stream;
-	for (HouseTile* tile : house->getTiles()) {
-		saveTile(stream, tile);
-
-		size_t attributesSize;
-		const char* attributes = stream.getStream(attributesSize);
-		if (attributesSize > 0) {
-			if (!stmt.addRow(fmt::format("{:d}, {:s}", houseId, db.escapeBlob(attributes, attributesSize)))) {
-				return false;
-			}
-			stream.clear();
+	for (const std::string& tile : tiles) {
+		if (!stmt.addRow(fmt::format("{:d}, {:s}", houseId, db.escapeBlob(tile.data(), tile.size())))) {
+			return false;
 		}
 	}
 
@@ -469,5 +501,10 @@ bool IOMapSerialize::saveHouse(House* house)
 	}
 
 	//End the transaction
-	return transaction.commit();
+	if (!transaction.commit()) {
+		return false;
+	}
+
+	house->setTileStoreHash(hash);
+	return true;
 }
@@ -13,6 +13,13 @@ class PropStream;
 class PropWriteStream;
 class Tile;
 
+// tile_store statements of a save and the hashes to remember once they are committed
+struct HouseItemsSaveData {
+	std::vector<std::string> queries;
+	std::vector<std::pair<uint32_t, uint64_t>> tileHashes;
+	bool fullRewrite = false;
+};
+
 class IOMapSerialize
 {
 	public:
@@ -23,12 +30,20 @@ class IOMapSerialize
 
 		static bool saveHouse(House* house);
 
+		// build the statements on the dispatcher, executing them is left to the caller
+		static void buildHouseInfoSave(std::vector<std::string>& queries);
+		static void buildHouseItemsSave(HouseItemsSaveData& data);
+		static void applyHouseItemsSave(const HouseItemsSaveData& data);
+
 	private:
 		static void saveItem(PropWriteStream& stream, const Item* item);
 		static void saveTile(PropWriteStream& stream, const Tile* tile);
+		static uint64_t serializeHouseTiles(const House* house, std::vector<std::string>& tiles);
 
 		static bool loadContainer(PropStream& propStream, Container* container);
 		static bool loadItem(PropStream& propStream, Cylinder* parent);
+
+		static bool tileStoreWritten;
 };
 
 #endif
@@ -193,6 +193,11 @@ bool Item::equals(const Item* otherItem) const
 		return false;
 	}
 
+	//same bits, so the integer attributes are stored in the same order
+	if (attributes->intAttributes != otherAttributes->intAttributes) {
+		return false;
+	}
+
 	const auto& attributeList = attributes->attributes;
 	const auto& otherAttributeList = otherAttributes->attributes;
 	for (const auto& attribute : attributeList) {
@@ -202,12 +207,6 @@ bool Item::equals(const Item* otherItem) const
 					return false;
 				}
 			}
-		} else if (ItemAttributes::isIntAttrType(attribute.type)) {
-			for (const auto& otherAttribute : otherAttributeList) {
-				if (attribute.type == otherAttribute.type && attribute.value.integer != otherAttribute.value.integer) {
-					return false;
-				}
-			}
 		} else if (ItemAttributes::isCustomAttrType(attribute.type)) {
 			for (const auto& otherAttribute : otherAttributeList) {
 				if (attribute.type == otherAttribute.type && *attribute.value.custom != *otherAttribute.value.custom) {
@@ -673,7 +672,7 @@ Attr_ReadValue Item::readAttr(AttrTypes_t attr, PropStream& propStream)
 					return ATTR_READ_ERROR;
 				}
 
-				getAttributes()->reflect[combatType] = reflect;
+				getAttributes()->getExtra().reflect[combatType] = reflect;
 			}
 			break;
 		}
@@ -692,7 +691,7 @@ Attr_ReadValue Item::readAttr(AttrTypes_t attr, PropStream& propStream)
 					return ATTR_READ_ERROR;
 				}
 
-				getAttributes()->boostPercent[combatType] = percent;
+				getAttributes()->getExtra().boostPercent[combatType] = percent;
 			}
 			break;
 		}
@@ -1008,8 +1007,8 @@ void Item::serializeAttr(PropWriteStream& propWriteStream) const
 		}
 	}
 
-	if (attributes) {
-		const auto& reflects = attributes->reflect;
+	if (attributes && attributes->extra) {
+		const auto& reflects = attributes->extra->reflect;
 		if (!reflects.empty()) {
 			propWriteStream.write<uint8_t>(ATTR_REFLECT);
 			propWriteStream.write<uint16_t>(reflects.size());
@@ -1021,7 +1020,7 @@ void Item::serializeAttr(PropWriteStream& propWriteStream) const
 			}
 		}
 
-		const auto& boosts = attributes->boostPercent;
+		const auto& boosts = attributes->extra->boostPercent;
 		if (!boosts.empty()) {
 			propWriteStream.write<uint8_t>(ATTR_BOOST);
 			propWriteStream.write<uint16_t>(boosts.size());
@@ -1032,7 +1031,7 @@ void Item::serializeAttr(PropWriteStream& propWriteStream) const
 			}
 		}
 
-		const auto& imbuements = attributes->imbuements;
+		const auto& imbuements = attributes->extra->imbuements;
 		if (!imbuements.empty()) {
 			propWriteStream.write<uint8_t>(ATTR_IMBUEMENTS);
 			propWriteStream.write<uint8_t>(imbuements.size());
@@ -1054,20 +1053,20 @@ void Item::serializeAttr(PropWriteStream& propWriteStream) const
 
 bool Item::hasProperty(ITEMPROPERTY prop) const
 {
-	const ItemType& it = items[id];
+	const HotItemType& it = items.getHotItemType(id);
 	switch (prop) {
-		case CONST_PROP_BLOCKSOLID: return it.blockSolid;
-		case CONST_PROP_MOVEABLE: return it.moveable && !hasAttribute(ITEM_ATTRIBUTE_UNIQUEID);
-		case CONST_PROP_HASHEIGHT: return it.hasHeight;
-		case CONST_PROP_BLOCKPROJECTILE: return it.blockProjectile;
-		case CONST_PROP_BLOCKPATH: return it.blockPathFind;
-		case CONST_PROP_ISVERTICAL: return it.isVertical;
-		case CONST_PROP_ISHORIZONTAL: return it.isHorizontal;
-		case CONST_PROP_IMMOVABLEBLOCKSOLID: return it.blockSolid && (!it.moveable || hasAttribute(ITEM_ATTRIBUTE_UNIQUEID));
-		case CONST_PROP_IMMOVABLEBLOCKPATH: return it.blockPathFind && (!it.moveable || hasAttribute(ITEM_ATTRIBUTE_UNIQUEID));
-		case CONST_PROP_IMMOVABLENOFIELDBLOCKPATH: return !it.isMagicField() && it.blockPathFind && (!it.moveable || hasAttribute(ITEM_ATTRIBUTE_UNIQUEID));
-		case CONST_PROP_NOFIELDBLOCKPATH: return !it.isMagicField() && it.blockPathFind;
-		case CONST_PROP_SUPPORTHANGABLE: return it.isHorizontal || it.isVertical;
+		case CONST_PROP_BLOCKSOLID: return it.hasFlag(HotItemType::BLOCK_SOLID);
+		case CONST_PROP_MOVEABLE: return it.hasFlag(HotItemType::MOVEABLE) && !hasAttribute(ITEM_ATTRIBUTE_UNIQUEID);
+		case CONST_PROP_HASHEIGHT: return it.hasFlag(HotItemType::HAS_HEIGHT);
+		case CONST_PROP_BLOCKPROJECTILE: return it.hasFlag(HotItemType::BLOCK_PROJECTILE);
+		case CONST_PROP_BLOCKPATH: return it.hasFlag(HotItemType::BLOCK_PATHFIND);
+		case CONST_PROP_ISVERTICAL: return it.hasFlag(HotItemType::VERTICAL);
+		case CONST_PROP_ISHORIZONTAL: return it.hasFlag(HotItemType::HORIZONTAL);
+		case CONST_PROP_IMMOVABLEBLOCKSOLID: return it.hasFlag(HotItemType::BLOCK_SOLID) && (!it.hasFlag(HotItemType::MOVEABLE) || hasAttribute(ITEM_ATTRIBUTE_UNIQUEID));
+		case CONST_PROP_IMMOVABLEBLOCKPATH: return it.hasFlag(HotItemType::BLOCK_PATHFIND) && (!it.hasFlag(HotItemType::MOVEABLE) || hasAttribute(ITEM_ATTRIBUTE_UNIQUEID));
+		case CONST_PROP_IMMOVABLENOFIELDBLOCKPATH: return !it.hasFlag(HotItemType::MAGIC_FIELD) && it.hasFlag(HotItemType::BLOCK_PATHFIND) && (!it.hasFlag(HotItemType::MOVEABLE) || hasAttribute(ITEM_ATTRIBUTE_UNIQUEID));
+		case CONST_PROP_NOFIELDBLOCKPATH: return !it.hasFlag(HotItemType::MAGIC_FIELD) && it.hasFlag(HotItemType::BLOCK_PATHFIND);
+		case CONST_PROP_SUPPORTHANGABLE: return it.hasFlag(HotItemType::HORIZONTAL) || it.hasFlag(HotItemType::VERTICAL);
 		default: return false;
 	}
 }
@@ -1253,6 +1252,43 @@ int64_t ItemAttributes::emptyInt;
 double ItemAttributes::emptyDouble;
 bool ItemAttributes::emptyBool;
 Reflect ItemAttributes::emptyReflect;
+std::map<uint8_t, Imbuement> ItemAttributes::emptyImbuements;
+
+ItemAttributes::ItemAttributes(const ItemAttributes& other) :
+	intAttributes(other.intAttributes), attributes(other.attributes), attributeBits(other.attributeBits),
+	lootContainerId(other.lootContainerId), imbuingSlots(other.imbuingSlots)
+{
+	if (other.extra) {
+		extra.reset(new ExtraAttributes(*other.extra));
+	}
+}
+
+size_t ItemAttributes::getMemoryUsage() const
+{
+	size_t bytes = 0;
+	if (intAttributes.capacity() > intAttributes.static_capacity) {
+		bytes += intAttributes.capacity() * sizeof(int64_t);
+	}
+
+	bytes += attributes.capacity() * sizeof(Attribute);
+	for (const Attribute& attribute : attributes) {
+		if (isStrAttrType(attribute.type)) {
+			bytes += sizeof(std::string) + attribute.value.string->capacity();
+		} else if (isCustomAttrType(attribute.type)) {
+			bytes += sizeof(CustomAttributeMap) + attribute.value.custom->size() * (sizeof(std::string) + sizeof(CustomAttribute));
+		}
+	}
+
+	if (extra) {
+		//rough, every map node carries about four pointers of overhead
+		constexpr size_t nodeOverhead = 4 * sizeof(void*);
+		bytes += sizeof(ExtraAttributes);
+		bytes += extra->reflect.size() * (sizeof(std::pair<CombatType_t, Reflect>) + nodeOverhead);
+		bytes += extra->boostPercent.size() * (sizeof(std::pair<CombatType_t, uint16_t>) + nodeOverhead);
+		bytes += extra->imbuements.size() * (sizeof(std::pair<uint8_t, Imbuement>) + nodeOverhead);
+	}
+	return bytes;
+}
 
 const std::string& ItemAttributes::getStrAttr(itemAttrTypes type) const
 {
@@ -1288,6 +1324,12 @@ void ItemAttributes::removeAttribute(itemAttrTypes type)
 		return;
 	}
 
+	if (isIntAttrType(type)) {
+		intAttributes.erase(intAttributes.begin() + getIntAttrIndex(type));
+		attributeBits &= ~type;
+		return;
+	}
+
 	auto prev_it = attributes.rbegin();
 	if ((*prev_it).type == type) {
 		attributes.pop_back();
@@ -1306,15 +1348,10 @@ void ItemAttributes::removeAttribute(itemAttrTypes type)
 
 int64_t ItemAttributes::getIntAttr(itemAttrTypes type) const
 {
-	if (!isIntAttrType(type)) {
+	if (!isIntAttrType(type) || !hasAttribute(type)) {
 		return 0;
 	}
-
-	const Attribute* attr = getExistingAttr(type);
-	if (!attr) {
-		return 0;
-	}
-	return attr->value.integer;
+	return intAttributes[getIntAttrIndex(type)];
 }
 
 void ItemAttributes::setIntAttr(itemAttrTypes type, int64_t value)
@@ -1327,7 +1364,13 @@ void ItemAttributes::setIntAttr(itemAttrTypes type, int64_t value)
 		value = 100;
 	}
 
-	getAttr(type).value.integer = value;
+	const size_t index = getIntAttrIndex(type);
+	if (hasAttribute(type)) {
+		intAttributes[index] = value;
+	} else {
+		intAttributes.insert(intAttributes.begin() + index, value);
+		attributeBits |= type;
+	}
 }
 
 void ItemAttributes::increaseIntAttr(itemAttrTypes type, int64_t value)
@@ -1374,6 +1417,22 @@ void Item::stopDecaying()
 	}
 }
 
+size_t Item::getMemoryUsage() const
+{
+	size_t bytes = sizeof(Item);
+	if (attributes) {
+		bytes += sizeof(ItemAttributes) + attributes->getMemoryUsage();
+	}
+
+	if (const Container* container = getContainer()) {
+		bytes += sizeof(Container) - sizeof(Item);
+		for (const Item* item : container->getItemList()) {
+			bytes += sizeof(Item*) + item->getMemoryUsage();
+		}
+	}
+	return bytes;
+}
+
 bool Item::hasMarketAttributes() const
 {
 	if (!attributes) {
@@ -1393,8 +1452,8 @@ bool Item::hasMarketAttributes() const
 	}
 
 	// discard items with imbuements
-	if (attributes->imbuements.size() > 0) {
-		for (const auto& imbuInfo : attributes->imbuements) {
+	if (attributes->getImbuementsCount() > 0) {
+		for (const auto& imbuInfo : attributes->getImbuements()) {
 			if (imbuInfo.second.getDuration() != 0) {
 				return false;
 			}
@@ -1409,29 +1468,30 @@ bool Item::hasMarketAttributes() const
 	// discard items with other modified attributes
 	const ItemType& itemType = Item::items[id];
 
-	for (const auto& attr : attributes->getList()) {
-		if (attr.type == ITEM_ATTRIBUTE_TIER) {
-			// unclassified items with tier > 0
-			if (itemType.classification == 0 && attr.value.integer > 0) {
-				return false;
-			}
-		} else if (attr.type == ITEM_ATTRIBUTE_CHARGES) {
-			// items with charges different than default
-			uint16_t charges = static_cast<uint16_t>(attr.value.integer);
-			if (charges != items[id].charges) {
-				return false;
-			}
-		} else if (attr.type == ITEM_ATTRIBUTE_DURATION) {
-			// items with duration different than default
-			uint32_t duration = static_cast<uint32_t>(attr.value.integer);
-			if (duration != getDefaultDuration()) {
-				return false;
-			}
-		} else {
-			// custom attributes (if there are more than 0 of them assigned)
-			if (!(attr.type == ITEM_ATTRIBUTE_CUSTOM && attr.value.custom && attr.value.custom->size() == 0)) {
-				return false;
-			}
+	if ((attributes->attributeBits & ~(ITEM_ATTRIBUTE_TIER | ITEM_ATTRIBUTE_CHARGES | ITEM_ATTRIBUTE_DURATION | ITEM_ATTRIBUTE_CUSTOM)) != 0) {
+		return false;
+	}
+
+	// unclassified items with tier > 0
+	if (hasAttribute(ITEM_ATTRIBUTE_TIER) && itemType.classification == 0 && getIntAttr(ITEM_ATTRIBUTE_TIER) > 0) {
+		return false;
+	}
+
+	// items with charges different than default
+	if (hasAttribute(ITEM_ATTRIBUTE_CHARGES) && static_cast<uint16_t>(getIntAttr(ITEM_ATTRIBUTE_CHARGES)) != itemType.charges) {
+		return false;
+	}
+
+	// items with duration different than default
+	if (hasAttribute(ITEM_ATTRIBUTE_DURATION) && static_cast<uint32_t>(getIntAttr(ITEM_ATTRIBUTE_DURATION)) != getDefaultDuration()) {
+		return false;
+	}
+
+	// custom attributes (if there are more than 0 of them assigned)
+	if (hasAttribute(ITEM_ATTRIBUTE_CUSTOM)) {
+		const ItemAttributes::CustomAttributeMap* customAttrMap = attributes->getCustomAttributeMap();
+		if (!customAttrMap || !customAttrMap->empty()) {
+			return false;
 		}
 	}
 	return true;
@@ -1439,7 +1499,7 @@ bool Item::hasMarketAttributes() const
 
 void Item::refreshImbuements(Player* player, bool consumePassive, bool consumeInfight) {
 	// item was never customized
-	if (!attributes) {
+	if (!attributes || !attributes->extra) {
 		return;
 	}
 
@@ -1450,7 +1510,7 @@ void Item::refreshImbuements(Player* player, bool consumePassive, bool consumeIn
 
 	bool needRefresh = false;
 
-	std::map<uint8_t, Imbuement>& imbuements = getAttributes()->getImbuements();
+	std::map<uint8_t, Imbuement>& imbuements = attributes->extra->imbuements;
 	for (auto it = imbuements.begin(); it != imbuements.end(); ) {
 		bool erase = false;
 
@@ -8,6 +8,7 @@
 #include "imbuing.h"
 #include "items.h"
 #include "luascript.h"
+#include "objectpool.h"
 #include "thing.h"
 #include "tools.h"
 
@@ -107,6 +108,17 @@ class ItemAttributes
 {
 	public:
 		ItemAttributes() = default;
+		ItemAttributes(const ItemAttributes& other);
+
+		// non-assignable
+		ItemAttributes& operator=(const ItemAttributes&) = delete;
+
+		static void* operator new(size_t size) {
+			return ObjectPool::allocate(size, POOLED_ITEMATTRIBUTES);
+		}
+		static void operator delete(void* p, size_t size) {
+			ObjectPool::deallocate(p, size, POOLED_ITEMATTRIBUTES);
+		}
 
 		void setSpecialDescription(const std::string& desc) {
 			setStrAttr(ITEM_ATTRIBUTE_DESCRIPTION, desc);
@@ -334,29 +346,35 @@ class ItemAttributes
 		};
 
 		// imbuements on item
-		std::map<uint8_t, Imbuement>& getImbuements() {
-			return imbuements;
+		const std::map<uint8_t, Imbuement>& getImbuements() const {
+			return extra ? extra->imbuements : emptyImbuements;
 		}
-		size_t getImbuementsCount() {
-			return imbuements.size();
+		size_t getImbuementsCount() const {
+			return extra ? extra->imbuements.size() : 0;
 		}
 
 		// imbuement active on slot
 		Imbuement* getImbuement(uint8_t slotId) {
-			auto it = imbuements.find(slotId);
-			if (it == imbuements.end()) {
+			if (!extra) {
 				return nullptr;
 			}
 
-			return &imbuements[slotId];
+			auto it = extra->imbuements.find(slotId);
+			if (it == extra->imbuements.end()) {
+				return nullptr;
+			}
+			return &it->second;
 		}
 		void setImbuement(Imbuement imbuement) {
-			this->imbuements[imbuement.getSlotId()] = imbuement;
+			getExtra().imbuements[imbuement.getSlotId()] = imbuement;
 		}
 		bool removeImbuement(uint8_t slotId) {
-			return this->imbuements.erase(slotId);
+			return extra && extra->imbuements.erase(slotId) != 0;
 		}
 
+		// heap bytes owned by these attributes, not counting the object itself
+		size_t getMemoryUsage() const;
+
 	private:
 		bool hasAttribute(itemAttrTypes type) const {
 			return (type & attributeBits) != 0;
@@ -368,6 +386,7 @@ class ItemAttributes
 		static double emptyDouble;
 		static bool emptyBool;
 		static Reflect emptyReflect;
+		static std::map<uint8_t, Imbuement> emptyImbuements;
 
 		typedef std::unordered_map<std::string, CustomAttribute> CustomAttributeMap;
 
@@ -433,22 +452,48 @@ class ItemAttributes
 			}
 		};
 
+		// rarely used attributes, allocated on first use
+		struct ExtraAttributes {
+			std::map<CombatType_t, Reflect> reflect;
+			std::map<CombatType_t, uint16_t> boostPercent;
+			std::map<uint8_t, Imbuement> imbuements;
+		};
+
+		// integer attributes inline, ordered by their bit in attributeBits
+		boost::container::small_vector<int64_t, 2> intAttributes;
+		// strings and custom attributes
 		std::vector<Attribute> attributes;
+		std::unique_ptr<ExtraAttributes> extra;
 		uint32_t attributeBits = 0;
 		int32_t lootContainerId = 0;
 		int16_t imbuingSlots = -1; // if -1 then inherit from ItemType
 
-		std::map<CombatType_t, Reflect> reflect;
-		std::map<CombatType_t, uint16_t> boostPercent;
-		std::map<uint8_t, Imbuement> imbuements;
+		ExtraAttributes& getExtra() {
+			if (!extra) {
+				extra.reset(new ExtraAttributes());
+			}
+			return *extra;
+		}
+
+		const Reflect& getReflect(CombatType_t combatType) const {
+			if (!extra) {
+				return emptyReflect;
+			}
+
+			auto it = extra->reflect.find(combatType);
+			return it != extra->reflect.end() ? it->second : emptyReflect;
+		}
+		int16_t getBoostPercent(CombatType_t combatType) const {
+			if (!extra) {
+				return 0;
+			}
 
-		const Reflect& getReflect(CombatType_t combatType) {
-			auto it = reflect.find(combatType);
-			return it != reflect.end() ? it->second : emptyReflect;
+			auto it = extra->boostPercent.find(combatType);
+			return it != extra->boostPercent.end() ? it->second : 0;
 		}
-		int16_t getBoostPercent(CombatType_t combatType) {
-			auto it = boostPercent.find(combatType);
-			return it != boostPercent.end() ? it->second : 0;
+
+		size_t getIntAttrIndex(itemAttrTypes type) const {
+			return std::bitset<32>(attributeBits & intAttributeTypes & (type - 1)).count();
 		}
 
 		const std::string& getStrAttr(itemAttrTypes type) const;
@@ -558,10 +603,6 @@ class ItemAttributes
 			return (type & ITEM_ATTRIBUTE_CUSTOM) == type;
 		}
 
-		const std::vector<Attribute>& getList() const {
-			return attributes;
-		}
-
 	friend class Item;
 };
 
@@ -584,6 +625,16 @@ class Item : virtual public Thing
 		// non-assignable
 		Item& operator=(const Item&) = delete;
 
+		// derived types (containers, teleports, fields...) are pooled by their own size,
+		// the virtual destructor passes the size of the dynamic type and picks the
+		// operator delete of the types that declare their own to be counted apart
+		static void* operator new(size_t size) {
+			return ObjectPool::allocate(size, POOLED_ITEM);
+		}
+		static void operator delete(void* p, size_t size) {
+			ObjectPool::deallocate(p, size, POOLED_ITEM);
+		}
+
 		bool equals(const Item* otherItem) const;
 
 		void update() {
@@ -924,8 +975,11 @@ class Item : virtual public Thing
 		}
 
 		// Imbuements
-		const std::map<uint8_t, Imbuement>& getImbuements() {
-			return getAttributes()->getImbuements();
+		const std::map<uint8_t, Imbuement>& getImbuements() const {
+			if (!attributes) {
+				return ItemAttributes::emptyImbuements;
+			}
+			return attributes->getImbuements();
 		}
 		void refreshImbuements(Player* player, bool consumePassive = false, bool consumeInfight = false);
 		ItemImbuInfo_t getStaticImbuements(bool inCombat);
@@ -998,7 +1052,7 @@ class Item : virtual public Thing
 			if (hasAttribute(ITEM_ATTRIBUTE_WEIGHT)) {
 				return getIntAttr(ITEM_ATTRIBUTE_WEIGHT);
 			}
-			return items[id].weight;
+			return items.getHotItemType(id).weight;
 		}
 		int32_t getAttack() const {
 			if (hasAttribute(ITEM_ATTRIBUTE_ATTACK)) {
@@ -1046,42 +1100,42 @@ class Item : virtual public Thing
 		int16_t getReflectDamage() const;
 
 		void setReflect(CombatType_t combatType, const Reflect& reflect) {
-			getAttributes()->reflect[combatType] = reflect;
+			getAttributes()->getExtra().reflect[combatType] = reflect;
 		}
 		Reflect getReflect(CombatType_t combatType, bool total = true) const;
 
 		void setBoostPercent(CombatType_t combatType, uint16_t value) {
-			getAttributes()->boostPercent[combatType] = value;
+			getAttributes()->getExtra().boostPercent[combatType] = value;
 		}
 		uint16_t getBoostPercent(CombatType_t combatType, bool total = true) const;
 
 		bool hasProperty(ITEMPROPERTY prop) const;
 		bool isBlocking() const {
-			return items[id].blockSolid;
+			return items.getHotItemType(id).hasFlag(HotItemType::BLOCK_SOLID);
 		}
 		bool isStackable() const {
-			return items[id].stackable;
+			return items.getHotItemType(id).hasFlag(HotItemType::STACKABLE);
 		}
 		bool isAlwaysOnTop() const {
-			return items[id].alwaysOnTop;
+			return items.getHotItemType(id).hasFlag(HotItemType::ALWAYS_ON_TOP);
 		}
 		bool isGroundTile() const {
-			return items[id].isGroundTile();
+			return items.getHotItemType(id).hasFlag(HotItemType::GROUND);
 		}
 		bool isMagicField() const {
-			return items[id].isMagicField();
+			return items.getHotItemType(id).hasFlag(HotItemType::MAGIC_FIELD);
 		}
 		bool isMoveable() const {
-			return items[id].moveable;
+			return items.getHotItemType(id).hasFlag(HotItemType::MOVEABLE);
 		}
 		bool isPickupable() const {
-			return items[id].pickupable;
+			return items.getHotItemType(id).hasFlag(HotItemType::PICKUPABLE);
 		}
 		bool isUseable() const {
 			return items[id].useable;
 		}
 		bool isHangable() const {
-			return items[id].isHangable;
+			return items.getHotItemType(id).hasFlag(HotItemType::HANGABLE);
 		}
 		bool isRotatable() const {
 			const ItemType& it = items[id];
@@ -1092,7 +1146,7 @@ class Item : virtual public Thing
 			return it.isPodium();
 		}
 		bool hasWalkStack() const {
-			return items[id].walkStack;
+			return items.getHotItemType(id).hasFlag(HotItemType::WALK_STACK);
 		}
 		bool hasForceSerialize() const {
 			return items[id].forceSerialize;
@@ -1188,6 +1242,9 @@ class Item : virtual public Thing
 
 		bool hasMarketAttributes() const;
 
+		// approximate bytes held by this item, its attributes and the items inside it
+		size_t getMemoryUsage() const;
+
 		bool hasAttributes() const {
 			return attributes ? true : false;
 		}
@@ -293,9 +293,39 @@ Items::Items()
 	nameToItems.reserve(0xFFFF);
 }
 
+HotItemType::HotItemType(const ItemType& it) :
+	weight(it.weight), alwaysOnTopOrder(it.alwaysOnTopOrder), floorChange(it.floorChange)
+{
+	const std::pair<bool, Flag> fields[] = {
+		{it.blockSolid, BLOCK_SOLID},
+		{it.blockProjectile, BLOCK_PROJECTILE},
+		{it.blockPathFind, BLOCK_PATHFIND},
+		{it.hasHeight, HAS_HEIGHT},
+		{it.moveable, MOVEABLE},
+		{it.pickupable, PICKUPABLE},
+		{it.allowPickupable, ALLOW_PICKUPABLE},
+		{it.stackable, STACKABLE},
+		{it.alwaysOnTop, ALWAYS_ON_TOP},
+		{it.walkStack, WALK_STACK},
+		{it.isVertical, VERTICAL},
+		{it.isHorizontal, HORIZONTAL},
+		{it.isHangable, HANGABLE},
+		{it.isGroundTile(), GROUND},
+		{it.isMagicField(), MAGIC_FIELD},
+		{it.isBed(), BED},
+	};
+
+	for (const auto& field : fields) {
+		if (field.first) {
+			flags |= field.second;
+		}
+	}
+}
+
 void Items::clear()
 {
 	items.clear();
+	hotItems.clear();
 	clientIdToServerIdMap.clear();
 	nameToItems.clear();
 	currencyItems.clear();
@@ -325,6 +355,9 @@ bool Items::reload()
 	loadFromOtb("data/items/items.otb", true);
 	loadFromXml();
 
+	//field damage comes from the item types, tiles keep it in a flag
+	g_game.map.refreshFieldFlags();
+
 	g_moveEvents->reload();
 	g_weapons->reload();
 	g_weapons->loadDefaults();
@@ -632,6 +665,7 @@ bool Items::loadFromOtb(const std::string& file, bool isReload)
 	}
 
 	items.shrink_to_fit();
+	buildHotItems();
 
 	// show how many items loaded
 	console::printResultText(console::getColumns("Items:", std::to_string(Item::items.size())));
@@ -644,19 +678,21 @@ bool Items::loadFromOtb(const std::string& file, bool isReload)
 	return true;
 }
 
-bool Items::loadFromXml()
+bool Items::loadFromXml(std::shared_ptr<pugi::xml_document> doc /*= nullptr*/)
 {
-	pugi::xml_document doc;
-	pugi::xml_parse_result result = doc.load_file("data/items/items.xml");
-	if (!result) {
-		printXMLError("Items::loadFromXml", "data/items/items.xml", result);
-		return false;
+	if (!doc) {
+		doc = std::make_shared<pugi::xml_document>();
+		pugi::xml_parse_result result = doc->load_file("data/items/items.xml");
+		if (!result) {
+			printXMLError("Items::loadFromXml", "data/items/items.xml", result);
+			return false;
+		}
 	}
 
 	uint16_t previousId = 0;
 	uint16_t currentId = 0;
 
-	for (auto itemNode : doc.child("items").children()) {
+	for (auto itemNode : doc->child("items").children()) {
 		pugi::xml_attribute idAttribute = itemNode.attribute("id");
 		if (idAttribute) {
 			currentId = pugi::cast<uint16_t>(idAttribute.value());
@@ -686,9 +722,20 @@ bool Items::loadFromXml()
 		previousId = toId;
 	}
 
+	buildHotItems();
 	return true;
 }
 
+void Items::buildHotItems()
+{
+	std::vector<HotItemType> newHotItems;
+	newHotItems.reserve(items.size());
+	for (const ItemType& it : items) {
+		newHotItems.emplace_back(it);
+	}
+	hotItems = std::move(newHotItems);
+}
+
 void Items::parseItemNode(const pugi::xml_node& itemNode, uint16_t id)
 {
 	if (id > 0 && id < 100) {
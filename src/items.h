@@ -476,6 +476,49 @@ class ItemType
 		bool showClientDuration = false;
 };
 
+/*
+ * the ItemType fields read by tile, movement and pathfinding checks, packed
+ * into 8 bytes per id: the checks walk a dense array instead of pulling
+ * ItemType cache lines full of names and descriptions. Built from the
+ * ItemTypes once items.xml is loaded, ItemType stays the source of truth
+ */
+class HotItemType
+{
+	public:
+		enum Flag : uint16_t {
+			BLOCK_SOLID = 1 << 0,
+			BLOCK_PROJECTILE = 1 << 1,
+			BLOCK_PATHFIND = 1 << 2,
+			HAS_HEIGHT = 1 << 3,
+			MOVEABLE = 1 << 4,
+			PICKUPABLE = 1 << 5,
+			ALLOW_PICKUPABLE = 1 << 6,
+			STACKABLE = 1 << 7,
+			ALWAYS_ON_TOP = 1 << 8,
+			WALK_STACK = 1 << 9,
+			VERTICAL = 1 << 10,
+			HORIZONTAL = 1 << 11,
+			HANGABLE = 1 << 12,
+			GROUND = 1 << 13,
+			MAGIC_FIELD = 1 << 14,
+			BED = 1 << 15,
+		};
+
+		HotItemType() = default;
+		explicit HotItemType(const ItemType& it);
+
+		bool hasFlag(Flag flag) const {
+			return (flags & flag) != 0;
+		}
+
+		uint32_t weight = 0;
+		uint16_t flags = 0;
+		uint8_t alwaysOnTopOrder = 0;
+		uint8_t floorChange = 0;
+};
+
+static_assert(sizeof(HotItemType) == 8, "HotItemType should stay 8 bytes");
+
 class Items
 {
 	public:
@@ -500,6 +543,15 @@ class Items
 		}
 		const ItemType& getItemType(size_t id) const;
 		ItemType& getItemType(size_t id);
+		const HotItemType& getHotItemType(size_t id) const {
+			if (id < hotItems.size()) {
+				return hotItems[id];
+			}
+
+			//unknown ids, and any id while the table is empty during a reload, get a type without properties
+			static const HotItemType dummyHotItemType {};
+			return dummyHotItemType;
+		}
 		const ItemType& getItemIdByClientId(uint16_t spriteId) const;
 
 		uint16_t getItemIdByName(const std::string& name);
@@ -508,7 +560,8 @@ class Items
 		uint32_t minorVersion = 0;
 		uint32_t buildNumber = 0;
 
-		bool loadFromXml();
+		//doc is an already parsed items.xml, the file is read when it is not given
+		bool loadFromXml(std::shared_ptr<pugi::xml_document> doc = nullptr);
 		void parseItemNode(const pugi::xml_node& itemNode, uint16_t id);
 
 		bool setImbuingSlots(size_t id, uint8_t count);
@@ -523,7 +576,11 @@ class Items
 		static uint64_t lastSavedLootContainerAutoId;
 		static uint64_t lootContainerAutoId;
 	private:
+		//hot fields are only written while loading, the table is rebuilt after every load
+		void buildHotItems();
+
 		std::vector<ItemType> items;
+		std::vector<HotItemType> hotItems;
 		InventoryVector inventory;
 		class ClientIdToServerIdMap
 		{
@@ -16,8 +16,7 @@ int LuaScriptInterface::luaContainerCreate(lua_State* L)
 
 	Container* container = getScriptEnv()->getContainerByUID(id);
 	if (container) {
-		pushUserdata(L, container);
-		setMetatable(L, -1, "Container");
+		pushUserdata(L, container, LuaData_Container);
 	} else {
 		lua_pushnil(L);
 	}
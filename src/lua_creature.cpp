@@ -563,8 +563,7 @@ int LuaScriptInterface::luaCreatureGetTile(lua_State* L)
 
 	Tile* tile = creature->getTile();
 	if (tile) {
-		pushUserdata<Tile>(L, tile);
-		setMetatable(L, -1, "Tile");
+		pushUserdata<Tile>(L, tile, LuaData_Tile);
 	} else {
 		lua_pushnil(L);
 	}
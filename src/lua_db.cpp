@@ -31,8 +31,15 @@ int LuaScriptInterface::luaDatabaseExecute(lua_State* L)
 
 int LuaScriptInterface::luaDatabaseAsyncExecute(lua_State* L)
 {
+	// db.asyncQuery(query[, callback[, orderingKey]])
+	uint32_t orderingKey = DatabaseTasks::NO_ORDERING_KEY;
+	if (lua_gettop(L) > 2) {
+		orderingKey = getNumber<uint32_t>(L, 3);
+		lua_settop(L, 2);
+	}
+
 	std::function<void(DBResult_ptr, bool)> callback;
-	if (lua_gettop(L) > 1) {
+	if (isFunction(L, 2)) {
 		int32_t ref = luaL_ref(L, LUA_REGISTRYINDEX);
 		auto scriptId = getScriptEnv()->getScriptId();
 		callback = [ref, scriptId](DBResult_ptr, bool success) {
@@ -55,7 +62,7 @@ int LuaScriptInterface::luaDatabaseAsyncExecute(lua_State* L)
 			luaL_unref(luaState, LUA_REGISTRYINDEX, ref);
 		};
 	}
-	g_databaseTasks.addTask(getString(L, -1), callback);
+	g_databaseTasks.addTask(getString(L, 1), callback, false, orderingKey);
 	return 0;
 }
 
@@ -72,8 +79,15 @@ int LuaScriptInterface::luaDatabaseStoreQuery(lua_State* L)
 
 int LuaScriptInterface::luaDatabaseAsyncStoreQuery(lua_State* L)
 {
+	// db.asyncStoreQuery(query[, callback[, orderingKey]])
+	uint32_t orderingKey = DatabaseTasks::NO_ORDERING_KEY;
+	if (lua_gettop(L) > 2) {
+		orderingKey = getNumber<uint32_t>(L, 3);
+		lua_settop(L, 2);
+	}
+
 	std::function<void(DBResult_ptr, bool)> callback;
-	if (lua_gettop(L) > 1) {
+	if (isFunction(L, 2)) {
 		int32_t ref = luaL_ref(L, LUA_REGISTRYINDEX);
 		auto scriptId = getScriptEnv()->getScriptId();
 		callback = [ref, scriptId](DBResult_ptr result, bool) {
@@ -101,7 +115,7 @@ int LuaScriptInterface::luaDatabaseAsyncStoreQuery(lua_State* L)
 			luaL_unref(luaState, LUA_REGISTRYINDEX, ref);
 		};
 	}
-	g_databaseTasks.addTask(getString(L, -1), callback, true);
+	g_databaseTasks.addTask(getString(L, 1), callback, true, orderingKey);
 	return 0;
 }
 
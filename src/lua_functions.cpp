@@ -571,7 +571,11 @@ int LuaScriptInterface::luaStopEvent(lua_State* L)
 
 int LuaScriptInterface::luaSaveServer(lua_State* L)
 {
-	g_game.saveGameState();
+	if (g_config.getBoolean(ConfigManager::SERVER_SAVE_IN_BACKGROUND) && g_game.getGameState() == GAME_STATE_NORMAL) {
+		g_game.saveGameStateInBackground();
+	} else {
+		g_game.saveGameState();
+	}
 	pushBoolean(L, true);
 	return 1;
 }
@@ -8,6 +8,7 @@
 #include "configmanager.h"
 #include "events.h"
 #include "iologindata.h"
+#include "luaprofiler.h"
 #include "monster.h"
 #include "game.h"
 #include "item.h"
@@ -59,8 +60,7 @@ int LuaScriptInterface::luaGameGetPlayers(lua_State* L)
 
 	int index = 0;
 	for (const auto& playerEntry : g_game.getPlayers()) {
-		pushUserdata<Player>(L, playerEntry.second);
-		setMetatable(L, -1, "Player");
+		pushUserdata<Player>(L, playerEntry.second, LuaData_Player);
 		lua_rawseti(L, -2, ++index);
 	}
 	return 1;
@@ -533,8 +533,7 @@ int LuaScriptInterface::luaGameCreateContainer(lua_State* L)
 		container->setParent(VirtualCylinder::virtualCylinder);
 	}
 
-	pushUserdata<Container>(L, container);
-	setMetatable(L, -1, "Container");
+	pushUserdata<Container>(L, container, LuaData_Container);
 	return 1;
 }
 
@@ -554,8 +553,7 @@ int LuaScriptInterface::luaGameCreateMonster(lua_State* L)
 
 	if (g_events->eventMonsterOnSpawn(monster, position, false, true) || force) {
 		if (g_game.placeCreature(monster, position, extended, force, magicEffect)) {
-			pushUserdata<Monster>(L, monster);
-			setMetatable(L, -1, "Monster");
+			pushUserdata<Monster>(L, monster, LuaData_Monster);
 		} else {
 			delete monster;
 			lua_pushboolean(L, false);
@@ -582,8 +580,7 @@ int LuaScriptInterface::luaGameCreateNpc(lua_State* L)
 	MagicEffectClasses magicEffect = getNumber<MagicEffectClasses>(L, 5, CONST_ME_TELEPORT);
 
 	if (g_game.placeCreature(npc, position, extended, force, magicEffect)) {
-		pushUserdata<Npc>(L, npc);
-		setMetatable(L, -1, "Npc");
+		pushUserdata<Npc>(L, npc, LuaData_Npc);
 	} else {
 		delete npc;
 		lua_pushboolean(L, false);
@@ -618,8 +615,7 @@ int LuaScriptInterface::luaGameCreateTile(lua_State* L)
 		g_game.map.setTile(position, tile);
 	}
 
-	pushUserdata(L, tile);
-	setMetatable(L, -1, "Tile");
+	pushUserdata(L, tile, LuaData_Tile);
 	return 1;
 }
 
@@ -915,3 +911,10 @@ int LuaScriptInterface::luaGameIsWindows(lua_State* L)
 #endif
 	return 1;
 }
+
+int LuaScriptInterface::luaGameToggleLuaProfiler(lua_State* L)
+{
+	// Game.toggleLuaProfiler()
+	pushBoolean(L, g_luaProfiler.toggle(g_luaEnvironment.getLuaState()));
+	return 1;
+}
@@ -62,8 +62,7 @@ int LuaScriptInterface::luaGuildGetMembersOnline(lua_State* L)
 
 	int index = 0;
 	for (Player* player : members) {
-		pushUserdata<Player>(L, player);
-		setMetatable(L, -1, "Player");
+		pushUserdata<Player>(L, player, LuaData_Player);
 		lua_rawseti(L, -2, ++index);
 	}
 	return 1;
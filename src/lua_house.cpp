@@ -355,8 +355,7 @@ int LuaScriptInterface::luaHouseGetTiles(lua_State* L)
 
 	int index = 0;
 	for (Tile* tile : tiles) {
-		pushUserdata<Tile>(L, tile);
-		setMetatable(L, -1, "Tile");
+		pushUserdata<Tile>(L, tile, LuaData_Tile);
 		lua_rawseti(L, -2, ++index);
 	}
 	return 1;
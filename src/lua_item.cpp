@@ -353,8 +353,7 @@ int LuaScriptInterface::luaItemGetTile(lua_State* L)
 
 	Tile* tile = item->getTile();
 	if (tile) {
-		pushUserdata<Tile>(L, tile);
-		setMetatable(L, -1, "Tile");
+		pushUserdata<Tile>(L, tile, LuaData_Tile);
 	} else {
 		lua_pushnil(L);
 	}
@@ -26,8 +26,7 @@ int LuaScriptInterface::luaMonsterCreate(lua_State* L)
 	}
 
 	if (monster) {
-		pushUserdata<Monster>(L, monster);
-		setMetatable(L, -1, "Monster");
+		pushUserdata<Monster>(L, monster, LuaData_Monster);
 	} else {
 		lua_pushnil(L);
 	}
@@ -34,8 +34,7 @@ int LuaScriptInterface::luaNpcCreate(lua_State* L)
 	}
 
 	if (npc) {
-		pushUserdata<Npc>(L, npc);
-		setMetatable(L, -1, "Npc");
+		pushUserdata<Npc>(L, npc, LuaData_Npc);
 	} else {
 		lua_pushnil(L);
 	}
@@ -57,8 +57,7 @@ int LuaScriptInterface::luaPartyGetLeader(lua_State* L)
 
 	Player* leader = party->getLeader();
 	if (leader) {
-		pushUserdata<Player>(L, leader);
-		setMetatable(L, -1, "Player");
+		pushUserdata<Player>(L, leader, LuaData_Player);
 	} else {
 		lua_pushnil(L);
 	}
@@ -90,8 +89,7 @@ int LuaScriptInterface::luaPartyGetMembers(lua_State* L)
 	int index = 0;
 	lua_createtable(L, party->getMemberCount(), 0);
 	for (Player* player : party->getMembers()) {
-		pushUserdata<Player>(L, player);
-		setMetatable(L, -1, "Player");
+		pushUserdata<Player>(L, player, LuaData_Player);
 		lua_rawseti(L, -2, ++index);
 	}
 	return 1;
@@ -109,8 +107,7 @@ int LuaScriptInterface::luaPartyGetActiveMembers(lua_State* L)
 	int index = 0;
 	lua_createtable(L, party->getMemberCount(), 0);
 	for (Player* player : party->getActiveMembers()) {
-		pushUserdata<Player>(L, player);
-		setMetatable(L, -1, "Player");
+		pushUserdata<Player>(L, player, LuaData_Player);
 		lua_rawseti(L, -2, ++index);
 	}
 	return 1;
@@ -137,8 +134,7 @@ int LuaScriptInterface::luaPartyGetInvitees(lua_State* L)
 
 		int index = 0;
 		for (Player* player : party->getInvitees()) {
-			pushUserdata<Player>(L, player);
-			setMetatable(L, -1, "Player");
+			pushUserdata<Player>(L, player, LuaData_Player);
 			lua_rawseti(L, -2, ++index);
 		}
 	} else {
@@ -50,8 +50,7 @@ int LuaScriptInterface::luaPlayerCreate(lua_State* L)
 	}
 
 	if (player) {
-		pushUserdata<Player>(L, player);
-		setMetatable(L, -1, "Player");
+		pushUserdata<Player>(L, player, LuaData_Player);
 	} else {
 		lua_pushnil(L);
 	}
@@ -121,6 +120,18 @@ int LuaScriptInterface::luaPlayerGetIp(lua_State* L)
 	return 1;
 }
 
+int LuaScriptInterface::luaPlayerGetSentBytes(lua_State* L)
+{
+	// player:getSentBytes()
+	Player* player = getUserdata<Player>(L, 1);
+	if (player) {
+		lua_pushnumber(L, player->getSentBytes());
+	} else {
+		lua_pushnil(L);
+	}
+	return 1;
+}
+
 int LuaScriptInterface::luaPlayerGetAccountId(lua_State* L)
 {
 	// player:getAccountId()
@@ -2569,8 +2580,7 @@ int LuaScriptInterface::luaPlayerGetContainerById(lua_State* L)
 
 	Container* container = player->getContainerByID(getNumber<uint8_t>(L, 2));
 	if (container) {
-		pushUserdata<Container>(L, container);
-		setMetatable(L, -1, "Container");
+		pushUserdata<Container>(L, container, LuaData_Container);
 	} else {
 		lua_pushnil(L);
 	}
@@ -2599,8 +2609,7 @@ int LuaScriptInterface::luaPlayerGetOpenContainers(lua_State* L)
 
 		lua_createtable(L, openContainers.size(), 0);
 		for (auto const& containerInfo : openContainers) {
-			pushUserdata<Container>(L, containerInfo.second.container);
-			setMetatable(L, -1, "Container");
+			pushUserdata<Container>(L, containerInfo.second.container, LuaData_Container);
 			lua_rawseti(L, -2, containerInfo.first);
 		}
 	} else {
@@ -2700,8 +2709,7 @@ int LuaScriptInterface::luaPlayerGetStoreInbox(lua_State* L)
 		return 1;
 	}
 
-	pushUserdata<Container>(L, storeInbox);
-	setMetatable(L, -1, "Container");
+	pushUserdata<Container>(L, storeInbox, LuaData_Container);
 	return 1;
 }
 
@@ -2733,8 +2741,7 @@ int LuaScriptInterface::luaPlayerGetTrainingDummy(lua_State* L)
 		return 1;
 	}
 
-	pushUserdata<Item>(L, dummy);
-	setMetatable(L, -1, "Item");
+	pushUserdata<Item>(L, dummy, LuaData_Item);
 	return 1;
 }
 
@@ -16,8 +16,7 @@ int LuaScriptInterface::luaPodiumCreate(lua_State* L)
 
 	Item* item = getScriptEnv()->getItemByUID(id);
 	if (item && item->getPodium()) {
-		pushUserdata(L, item);
-		setMetatable(L, -1, "Podium");
+		pushUserdata(L, item, LuaData_Podium);
 	} else {
 		lua_pushnil(L);
 	}
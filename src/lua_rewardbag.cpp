@@ -17,8 +17,7 @@ int LuaScriptInterface::luaRewardBagCreate(lua_State* L)
 		std::cout << "container" << std::endl;
 		if (RewardBag* rewardBag = rewardContainer->getRewardBag()) {
 			std::cout << "bag" << std::endl;
-			pushUserdata(L, rewardBag);
-			setMetatable(L, -1, "RewardBag");
+			pushUserdata(L, rewardBag, LuaData_RewardBag);
 			return 1;
 		}
 	}
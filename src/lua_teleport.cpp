@@ -16,8 +16,7 @@ int LuaScriptInterface::luaTeleportCreate(lua_State* L)
 
 	Item* item = getScriptEnv()->getItemByUID(id);
 	if (item && item->getTeleport()) {
-		pushUserdata(L, item);
-		setMetatable(L, -1, "Teleport");
+		pushUserdata(L, item, LuaData_Teleport);
 	} else {
 		lua_pushnil(L);
 	}
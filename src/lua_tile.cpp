@@ -26,8 +26,7 @@ int LuaScriptInterface::luaTileCreate(lua_State* L)
 	}
 
 	if (tile) {
-		pushUserdata<Tile>(L, tile);
-		setMetatable(L, -1, "Tile");
+		pushUserdata<Tile>(L, tile, LuaData_Tile);
 	} else {
 		lua_pushnil(L);
 	}
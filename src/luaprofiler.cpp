@@ -0,0 +1,161 @@
+// Copyright 2022 The Forgotten Server Authors. All rights reserved.
+// Use of this source code is governed by the GPL-2.0 License that can be found in the LICENSE file.
+
+#include "otpch.h"
+
+#include "luaprofiler.h"
+
+#include <fstream>
+
+LuaProfiler g_luaProfiler;
+
+namespace {
+
+// ';' separates frames in the collapsed stack format
+std::string sanitizeFrame(std::string name)
+{
+	std::replace(name.begin(), name.end(), ';', ':');
+	return name;
+}
+
+}
+
+void LuaProfiler::start(lua_State* L)
+{
+	if (enabled) {
+		return;
+	}
+
+	frames.clear();
+	callStacks.clear();
+	sampledStacks.clear();
+	startTime = time(nullptr);
+	enabled = true;
+
+	lua_sethook(L, sampleHook, LUA_MASKCOUNT, LUA_PROFILER_SAMPLE_INSTRUCTIONS);
+	console::print(CONSOLEMESSAGE_TYPE_INFO, "Lua profiler started.");
+}
+
+void LuaProfiler::stop(lua_State* L)
+{
+	if (!enabled) {
+		return;
+	}
+
+	lua_sethook(L, nullptr, 0, 0);
+	enabled = false;
+	frames.clear();
+
+	const std::string prefix = "lua_profile_" + std::to_string(startTime);
+	writeStacks(prefix + "_calls.folded", callStacks);
+	writeStacks(prefix + "_samples.folded", sampledStacks);
+	callStacks.clear();
+	sampledStacks.clear();
+
+	console::print(CONSOLEMESSAGE_TYPE_INFO, "Lua profiler stopped, profile written to data/logs/stats/" + prefix + "_*.folded.");
+}
+
+bool LuaProfiler::toggle(lua_State* L)
+{
+	if (enabled) {
+		stop(L);
+	} else {
+		start(L);
+	}
+	return enabled;
+}
+
+void LuaProfiler::enterCall(lua_State* L, const std::string& name)
+{
+	std::string frameName = sanitizeFrame(name);
+
+	// a nested call comes from C++ code invoked by Lua, name the binding in between
+	lua_Debug ar;
+	if (!frames.empty() && lua_getstack(L, 0, &ar) && lua_getinfo(L, "nS", &ar) && ar.what && std::strcmp(ar.what, "C") == 0) {
+		frameName = "[C] " + sanitizeFrame(ar.name ? ar.name : "?") + ';' + frameName;
+	}
+
+	frames.emplace_back(std::move(frameName), std::chrono::high_resolution_clock::now());
+}
+
+void LuaProfiler::leaveCall()
+{
+	// the profiler was stopped while this call was running
+	if (frames.empty()) {
+		return;
+	}
+
+	const Frame& frame = frames.back();
+	uint64_t elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - frame.startTime).count();
+	callStacks[getCallStack()] += elapsed - std::min(elapsed, frame.childTime);
+	frames.pop_back();
+
+	if (!frames.empty()) {
+		frames.back().childTime += elapsed;
+	}
+}
+
+void LuaProfiler::sampleHook(lua_State* L, lua_Debug*)
+{
+	g_luaProfiler.addSample(L);
+}
+
+void LuaProfiler::addSample(lua_State* L)
+{
+	//a hook installed on a coroutine thread outlives stop(), which only clears the main state
+	if (!enabled) {
+		return;
+	}
+
+	std::vector<std::string> luaFrames;
+
+	lua_Debug ar;
+	for (int level = 0; lua_getstack(L, level, &ar); ++level) {
+		if (!lua_getinfo(L, "nSl", &ar)) {
+			break;
+		}
+
+		std::ostringstream ss;
+		ss << ar.short_src << ':' << ar.linedefined;
+		if (ar.name) {
+			ss << ' ' << ar.name;
+		}
+		luaFrames.push_back(sanitizeFrame(ss.str()));
+	}
+
+	std::string stack = getCallStack();
+	for (auto it = luaFrames.rbegin(), end = luaFrames.rend(); it != end; ++it) {
+		if (!stack.empty()) {
+			stack.push_back(';');
+		}
+		stack.append(*it);
+	}
+	++sampledStacks[stack];
+}
+
+std::string LuaProfiler::getCallStack() const
+{
+	std::string stack;
+	for (const Frame& frame : frames) {
+		if (!stack.empty()) {
+			stack.push_back(';');
+		}
+		stack.append(frame.name);
+	}
+	return stack;
+}
+
+void LuaProfiler::writeStacks(const std::string& file, const StackMap& stacks) const
+{
+	std::ofstream out("data/logs/stats/" + file);
+	if (!out.is_open()) {
+		console::reportError("LuaProfiler::writeStacks", "Can't open data/logs/stats/" + file + " (check if directory exists)");
+		return;
+	}
+
+	for (const auto& it : stacks) {
+		if (it.second != 0) {
+			out << it.first << ' ' << it.second << '\n';
+		}
+	}
+}
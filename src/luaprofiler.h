@@ -0,0 +1,57 @@
+// Copyright 2022 The Forgotten Server Authors. All rights reserved.
+// Use of this source code is governed by the GPL-2.0 License that can be found in the LICENSE file.
+
+#ifndef FS_LUAPROFILER_H
+#define FS_LUAPROFILER_H
+
+static constexpr int32_t LUA_PROFILER_SAMPLE_INSTRUCTIONS = 1000;
+
+// Collects Lua timings per event callback and per Lua function while enabled.
+// Instrumented timings come from LuaScriptInterface::protectedCall, sampled stacks
+// from an instruction count hook. Both are written as collapsed stacks, the input
+// format of flamegraph tools, when the profiler is stopped.
+class LuaProfiler
+{
+	public:
+		bool isEnabled() const {
+			return enabled;
+		}
+
+		void start(lua_State* L);
+		void stop(lua_State* L);
+		bool toggle(lua_State* L);
+
+		void enterCall(lua_State* L, const std::string& name);
+		void leaveCall();
+
+	private:
+		using StackMap = std::unordered_map<std::string, uint64_t>;
+
+		struct Frame {
+			Frame(std::string name, std::chrono::high_resolution_clock::time_point startTime) :
+				name(std::move(name)), startTime(startTime) {}
+
+			std::string name;
+			std::chrono::high_resolution_clock::time_point startTime;
+			uint64_t childTime = 0;
+		};
+
+		static void sampleHook(lua_State* L, lua_Debug* ar);
+
+		void addSample(lua_State* L);
+		std::string getCallStack() const;
+		void writeStacks(const std::string& file, const StackMap& stacks) const;
+
+		std::vector<Frame> frames;
+		// collapsed stack -> self time in microseconds
+		StackMap callStacks;
+		// collapsed stack -> number of samples
+		StackMap sampledStacks;
+
+		time_t startTime = 0;
+		bool enabled = false;
+};
+
+extern LuaProfiler g_luaProfiler;
+
+#endif
@@ -8,6 +8,7 @@
 #include "combat.h"
 #include "configmanager.h"
 #include "game.h"
+#include "luaprofiler.h"
 #include "luavariant.h"
 #include "monster.h"
 #include "monsters.h"
@@ -19,6 +20,8 @@
 #include "teleport.h"
 
 #include <boost/range/adaptor/reversed.hpp>
+#include <filesystem>
+#include <fstream>
 
 extern ConfigManager g_config;
 extern Spells* g_spells;
@@ -31,6 +34,8 @@ ScriptEnvironment::DBResultMap ScriptEnvironment::tempResults;
 uint32_t ScriptEnvironment::lastResultId = 0;
 int32_t LuaScriptInterface::runningEventId = EVENT_ID_USER;
 std::map<int32_t, std::string> LuaScriptInterface::cacheFiles;
+int32_t LuaScriptInterface::metatableRefs[LuaData_Last] = {};
+std::unordered_map<std::string, int32_t> LuaScriptInterface::weakMetatableRefs;
 
 LuaEnvironment g_luaEnvironment;
 
@@ -275,6 +280,11 @@ int LuaScriptInterface::protectedCall(lua_State* L, int nargs, int nresults)
 	getScriptEnv()->getEventInfo(scriptId, scriptInterface, callbackId, timerEvent);
 #endif
 
+	const bool profiled = g_luaProfiler.isEnabled();
+	if (profiled) {
+		g_luaProfiler.enterCall(L, getProfilerFrameName());
+	}
+
 	int error_index = lua_gettop(L) - nargs;
 	lua_pushcfunction(L, luaErrorHandler);
 	lua_insert(L, error_index);
@@ -282,6 +292,10 @@ int LuaScriptInterface::protectedCall(lua_State* L, int nargs, int nresults)
 	int ret = lua_pcall(L, nargs, nresults, error_index);
 	lua_remove(L, error_index);
 
+	if (profiled) {
+		g_luaProfiler.leaveCall();
+	}
+
 #ifdef STATS_ENABLED
 	uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - time_point).count();
 	auto it = cacheFiles.find(scriptId);
@@ -292,10 +306,120 @@ int LuaScriptInterface::protectedCall(lua_State* L, int nargs, int nresults)
 	return ret;
 }
 
+std::string LuaScriptInterface::getProfilerFrameName()
+{
+	if (scriptEnvIndex < 0) {
+		return "(No script environment)";
+	}
+
+	int32_t scriptId;
+	int32_t callbackId;
+	bool timerEvent;
+	LuaScriptInterface* scriptInterface;
+	getScriptEnv()->getEventInfo(scriptId, scriptInterface, callbackId, timerEvent);
+
+	if (!scriptInterface) {
+		return "(Unknown interface)";
+	}
+
+	int32_t eventId = callbackId != 0 ? callbackId : scriptId;
+	return fmt::format("{:s} {:s} #{:d}", scriptInterface->getInterfaceName(), scriptInterface->getFileById(eventId), eventId);
+}
+
+namespace {
+
+constexpr auto LUA_BYTECODE_CACHE_DIRECTORY = "data/cache/lua";
+
+int writeBytecode(lua_State*, const void* data, size_t size, void* userdata)
+{
+	static_cast<std::string*>(userdata)->append(static_cast<const char*>(data), size);
+	return 0;
+}
+
+}
+
+int LuaScriptInterface::loadChunk(lua_State* L, const std::string& file)
+{
+	if (!g_config.getBoolean(ConfigManager::LUA_BYTECODE_CACHE)) {
+		return luaL_loadfile(L, file.c_str());
+	}
+
+	namespace fs = std::filesystem;
+
+	std::error_code ec;
+	const auto fileSize = fs::file_size(file, ec);
+	if (ec) {
+		//let lua report the missing file
+		return luaL_loadfile(L, file.c_str());
+	}
+
+	const auto lastWrite = fs::last_write_time(file, ec).time_since_epoch().count();
+	if (ec) {
+		return luaL_loadfile(L, file.c_str());
+	}
+
+	//one cache entry per source path and interpreter, bytecode produced by one runtime is not
+	//loadable by another; an edited script replaces its own entry so the directory does not grow
+#if defined(LUAJIT_VERSION)
+	const char* runtime = LUAJIT_VERSION;
+#else
+	const char* runtime = LUA_RELEASE;
+#endif
+	const uint64_t key = std::hash<std::string>{}(fmt::format("{:s}|{:s}", file, runtime));
+	const std::string cacheFile = fmt::format("{:s}/{:016x}.luac", LUA_BYTECODE_CACHE_DIRECTORY, key);
+	const std::string chunkName = '@' + file;
+
+	//the entry starts with the size and modification time of the source it was compiled from
+	const std::array<uint64_t, 2> header = {static_cast<uint64_t>(fileSize), static_cast<uint64_t>(lastWrite)};
+
+	std::ifstream cached(cacheFile, std::ios::binary);
+	if (cached) {
+		std::array<uint64_t, 2> cachedHeader;
+		if (cached.read(reinterpret_cast<char*>(cachedHeader.data()), sizeof(cachedHeader)) && cachedHeader == header) {
+			const std::string bytecode{std::istreambuf_iterator<char>(cached), std::istreambuf_iterator<char>()};
+			if (!bytecode.empty() && luaL_loadbuffer(L, bytecode.data(), bytecode.size(), chunkName.c_str()) == 0) {
+				return 0;
+			}
+
+			//truncated or foreign entry, compile from source and replace it
+			if (!bytecode.empty()) {
+				lua_pop(L, 1);
+			}
+		}
+	}
+
+	int ret = luaL_loadfile(L, file.c_str());
+	if (ret != 0) {
+		return ret;
+	}
+
+	std::string bytecode;
+#if LUA_VERSION_NUM >= 503
+	lua_dump(L, writeBytecode, &bytecode, 0);
+#else
+	lua_dump(L, writeBytecode, &bytecode);
+#endif
+	if (bytecode.empty()) {
+		return 0;
+	}
+
+	//write to a temporary file first so a concurrent or interrupted start never sees half an entry
+	fs::create_directories(LUA_BYTECODE_CACHE_DIRECTORY, ec);
+	const std::string tempFile = cacheFile + ".tmp";
+	std::ofstream output(tempFile, std::ios::binary | std::ios::trunc);
+	if (!output.write(reinterpret_cast<const char*>(header.data()), sizeof(header)) || !output.write(bytecode.data(), bytecode.size())) {
+		return 0;
+	}
+
+	output.close();
+	fs::rename(tempFile, cacheFile, ec);
+	return 0;
+}
+
 int32_t LuaScriptInterface::loadFile(const std::string& file, Npc* npc /* = nullptr*/)
 {
 	//loads file as a chunk at stack top
-	int ret = luaL_loadfile(luaState, file.c_str());
+	int ret = loadChunk(luaState, file);
 	if (ret != 0) {
 		lastLuaError = popString(luaState);
 		return -1;
@@ -413,6 +537,14 @@ int32_t LuaScriptInterface::getMetaEvent(const std::string& globalName, const st
 	return runningEventId++;
 }
 
+void LuaScriptInterface::setEventName(int32_t eventId, const std::string& eventName)
+{
+	auto it = cacheFiles.find(eventId);
+	if (it != cacheFiles.end()) {
+		it->second = it->second.substr(0, it->second.rfind(':') + 1) + eventName;
+	}
+}
+
 const std::string& LuaScriptInterface::getFileById(int32_t scriptId)
 {
 	if (scriptId == EVENT_ID_LOADING) {
@@ -625,8 +757,7 @@ void LuaScriptInterface::pushCylinder(lua_State* L, Cylinder* cylinder)
 		pushUserdata<Item>(L, parentItem);
 		setItemMetatable(L, -1, parentItem);
 	} else if (Tile* tile = cylinder->getTile()) {
-		pushUserdata<Tile>(L, tile);
-		setMetatable(L, -1, "Tile");
+		pushUserdata<Tile>(L, tile, LuaData_Tile);
 	} else if (cylinder == VirtualCylinder::virtualCylinder) {
 		pushBoolean(L, true);
 	} else {
@@ -669,65 +800,65 @@ void LuaScriptInterface::setMetatable(lua_State* L, int32_t index, const std::st
 
 void LuaScriptInterface::setWeakMetatable(lua_State* L, int32_t index, const std::string& name)
 {
-	static std::set<std::string> weakObjectTypes;
-	const std::string& weakName = name + "_weak";
+	auto it = weakMetatableRefs.find(name);
+	if (it != weakMetatableRefs.end()) {
+		lua_rawgeti(L, LUA_REGISTRYINDEX, it->second);
+		lua_setmetatable(L, index - 1);
+		return;
+	}
 
-	auto result = weakObjectTypes.emplace(name);
-	if (result.second) {
-		luaL_getmetatable(L, name.c_str());
-		int childMetatable = lua_gettop(L);
+	luaL_getmetatable(L, name.c_str());
+	int childMetatable = lua_gettop(L);
 
-		luaL_newmetatable(L, weakName.c_str());
-		int metatable = lua_gettop(L);
+	luaL_newmetatable(L, (name + "_weak").c_str());
+	int metatable = lua_gettop(L);
 
-		static const std::vector<std::string> methodKeys = {"__index", "__metatable", "__eq"};
-		for (const std::string& metaKey : methodKeys) {
-			lua_getfield(L, childMetatable, metaKey.c_str());
-			lua_setfield(L, metatable, metaKey.c_str());
-		}
+	static const std::vector<std::string> methodKeys = {"__index", "__metatable", "__eq"};
+	for (const std::string& metaKey : methodKeys) {
+		lua_getfield(L, childMetatable, metaKey.c_str());
+		lua_setfield(L, metatable, metaKey.c_str());
+	}
 
-		static const std::vector<int> methodIndexes = {'h', 'p', 't'};
-		for (int metaIndex : methodIndexes) {
-			lua_rawgeti(L, childMetatable, metaIndex);
-			lua_rawseti(L, metatable, metaIndex);
-		}
+	static const std::vector<int> methodIndexes = {'h', 'p', 't'};
+	for (int metaIndex : methodIndexes) {
+		lua_rawgeti(L, childMetatable, metaIndex);
+		lua_rawseti(L, metatable, metaIndex);
+	}
 
-		lua_pushnil(L);
-		lua_setfield(L, metatable, "__gc");
+	lua_pushnil(L);
+	lua_setfield(L, metatable, "__gc");
 
-		lua_remove(L, childMetatable);
-	} else {
-		luaL_getmetatable(L, weakName.c_str());
-	}
+	lua_remove(L, childMetatable);
+
+	lua_pushvalue(L, -1);
+	weakMetatableRefs[name] = luaL_ref(L, LUA_REGISTRYINDEX);
 	lua_setmetatable(L, index - 1);
 }
 
 void LuaScriptInterface::setItemMetatable(lua_State* L, int32_t index, const Item* item)
 {
 	if (item->getRewardBag()) {
-		luaL_getmetatable(L, "RewardBag");
+		setMetatable(L, index, LuaData_RewardBag);
 	} else if (item->getContainer()) {
-		luaL_getmetatable(L, "Container");
+		setMetatable(L, index, LuaData_Container);
 	} else if (item->getTeleport()) {
-		luaL_getmetatable(L, "Teleport");
+		setMetatable(L, index, LuaData_Teleport);
 	} else if (item->getPodium()) {
-		luaL_getmetatable(L, "Podium");
+		setMetatable(L, index, LuaData_Podium);
 	} else {
-		luaL_getmetatable(L, "Item");
+		setMetatable(L, index, LuaData_Item);
 	}
-	lua_setmetatable(L, index - 1);
 }
 
 void LuaScriptInterface::setCreatureMetatable(lua_State* L, int32_t index, const Creature* creature)
 {
 	if (creature->getPlayer()) {
-		luaL_getmetatable(L, "Player");
+		setMetatable(L, index, LuaData_Player);
 	} else if (creature->getMonster()) {
-		luaL_getmetatable(L, "Monster");
+		setMetatable(L, index, LuaData_Monster);
 	} else {
-		luaL_getmetatable(L, "Npc");
+		setMetatable(L, index, LuaData_Npc);
 	}
-	lua_setmetatable(L, index - 1);
 }
 
 // Get
@@ -2099,6 +2230,8 @@ void LuaScriptInterface::registerFunctions()
 	registerEnum(TILESTATE_FLOORCHANGE_SOUTH_ALT)
 	registerEnum(TILESTATE_FLOORCHANGE_EAST_ALT)
 	registerEnum(TILESTATE_SUPPORTS_HANGABLE)
+	registerEnum(TILESTATE_CREATURES)
+	registerEnum(TILESTATE_DAMAGINGFIELD)
 
 	registerEnum(WEAPON_NONE)
 	registerEnum(WEAPON_SWORD)
@@ -2672,6 +2805,8 @@ void LuaScriptInterface::registerFunctions()
 	registerMethod("Game", "isDevMode", LuaScriptInterface::luaGameIsDevMode);
 	registerMethod("Game", "isWindows", LuaScriptInterface::luaGameIsWindows);
 
+	registerMethod("Game", "toggleLuaProfiler", LuaScriptInterface::luaGameToggleLuaProfiler);
+
 	// Variant
 	registerClass("Variant", "", LuaScriptInterface::luaVariantCreate);
 
@@ -3045,6 +3180,7 @@ void LuaScriptInterface::registerFunctions()
 
 	registerMethod("Player", "getGuid", LuaScriptInterface::luaPlayerGetGuid);
 	registerMethod("Player", "getIp", LuaScriptInterface::luaPlayerGetIp);
+	registerMethod("Player", "getSentBytes", LuaScriptInterface::luaPlayerGetSentBytes);
 	registerMethod("Player", "getAccountId", LuaScriptInterface::luaPlayerGetAccountId);
 	registerMethod("Player", "getLastLoginSaved", LuaScriptInterface::luaPlayerGetLastLoginSaved);
 	registerMethod("Player", "getLastLogout", LuaScriptInterface::luaPlayerGetLastLogout);
@@ -3915,10 +4051,38 @@ void LuaScriptInterface::registerClass(const std::string& className, const std::
 	// setmetatable(className, methodsTable)
 	lua_setmetatable(luaState, methods);
 
+	LuaDataType type;
+	if (className == "Item") {
+		type = LuaData_Item;
+	} else if (className == "RewardBag") {
+		type = LuaData_RewardBag;
+	} else if (className == "Container") {
+		type = LuaData_Container;
+	} else if (className == "Teleport") {
+		type = LuaData_Teleport;
+	} else if (className == "Podium") {
+		type = LuaData_Podium;
+	} else if (className == "Player") {
+		type = LuaData_Player;
+	} else if (className == "Monster") {
+		type = LuaData_Monster;
+	} else if (className == "Npc") {
+		type = LuaData_Npc;
+	} else if (className == "Tile") {
+		type = LuaData_Tile;
+	} else {
+		type = LuaData_Unknown;
+	}
+
 	// className.metatable = {}
-	luaL_newmetatable(luaState, className.c_str());
+	bool newMetatable = luaL_newmetatable(luaState, className.c_str()) != 0;
 	int metatable = lua_gettop(luaState);
 
+	if (newMetatable && type != LuaData_Unknown) {
+		lua_pushvalue(luaState, metatable);
+		metatableRefs[type] = luaL_ref(luaState, LUA_REGISTRYINDEX);
+	}
+
 	// className.metatable.__metatable = className
 	lua_pushvalue(luaState, methods);
 	lua_setfield(luaState, metatable, "__metatable");
@@ -3936,27 +4100,7 @@ void LuaScriptInterface::registerClass(const std::string& className, const std::
 	lua_rawseti(luaState, metatable, 'p');
 
 	// className.metatable['t'] = type
-	if (className == "Item") {
-		lua_pushnumber(luaState, LuaData_Item);
-	} else if (className == "RewardBag") {
-		lua_pushnumber(luaState, LuaData_RewardBag);
-	} else if (className == "Container") {
-		lua_pushnumber(luaState, LuaData_Container);
-	} else if (className == "Teleport") {
-		lua_pushnumber(luaState, LuaData_Teleport);
-	} else if (className == "Podium") {
-		lua_pushnumber(luaState, LuaData_Podium);
-	} else if (className == "Player") {
-		lua_pushnumber(luaState, LuaData_Player);
-	} else if (className == "Monster") {
-		lua_pushnumber(luaState, LuaData_Monster);
-	} else if (className == "Npc") {
-		lua_pushnumber(luaState, LuaData_Npc);
-	} else if (className == "Tile") {
-		lua_pushnumber(luaState, LuaData_Tile);
-	} else {
-		lua_pushnumber(luaState, LuaData_Unknown);
-	}
+	lua_pushnumber(luaState, type);
 	lua_rawseti(luaState, metatable, 't');
 
 	// pop className, className.metatable
@@ -4217,6 +4361,7 @@ bool LuaEnvironment::closeState()
 	combatIdMap.clear();
 	areaIdMap.clear();
 	timerEvents.clear();
+	weakMetatableRefs.clear();
 	//cacheFiles.clear();
 
 	lua_close(luaState);
@@ -55,6 +55,8 @@ enum LuaDataType {
 	LuaData_Npc,
 	LuaData_Tile,
 	LuaData_RewardBag,
+
+	LuaData_Last
 };
 
 struct LuaTimerEventDesc {
@@ -182,6 +184,8 @@ class LuaScriptInterface
 		const std::string& getFileById(int32_t scriptId);
 		int32_t getEvent(const std::string& eventName);
 		int32_t getEvent();
+		// replaces the "callback" of an event from getEvent() with the name of the event it handles
+		void setEventName(int32_t eventId, const std::string& eventName);
 		int32_t getMetaEvent(const std::string& globalName, const std::string& eventName);
 
 		static ScriptEnvironment* getScriptEnv() {
@@ -235,6 +239,13 @@ class LuaScriptInterface
 			*userdata = value;
 		}
 
+		template<class T>
+		static void pushUserdata(lua_State* L, T* value, LuaDataType type)
+		{
+			pushUserdata<T>(L, value);
+			setMetatable(L, -1, type);
+		}
+
 		// Shared Ptr
 		template<class T>
 		static void pushSharedPtr(lua_State* L, T value)
@@ -244,6 +255,10 @@ class LuaScriptInterface
 
 		// Metatables
 		static void setMetatable(lua_State* L, int32_t index, const std::string& name);
+		static void setMetatable(lua_State* L, int32_t index, LuaDataType type) {
+			lua_rawgeti(L, LUA_REGISTRYINDEX, metatableRefs[type]);
+			lua_setmetatable(L, index - 1);
+		}
 		static void setWeakMetatable(lua_State* L, int32_t index, const std::string& name);
 
 		static void setItemMetatable(lua_State* L, int32_t index, const Item* item);
@@ -429,6 +444,10 @@ class LuaScriptInterface
 		//script file cache
 		static std::map<int32_t, std::string> cacheFiles; // previously not static
 
+		//registry references of the metatables of classes with a LuaDataType and of weak metatables
+		static int32_t metatableRefs[LuaData_Last];
+		static std::unordered_map<std::string, int32_t> weakMetatableRefs;
+
 	private:
 		void registerClass(const std::string& className, const std::string& baseClass, lua_CFunction newFunction = nullptr);
 		void registerTable(const std::string& tableName);
@@ -439,6 +458,10 @@ class LuaScriptInterface
 		void registerGlobalBoolean(const std::string& name, bool value);
 
 		static std::string getStackTrace(lua_State* L, const std::string& error_desc);
+		static std::string getProfilerFrameName();
+
+		//loads a script chunk, going through the bytecode cache when luaBytecodeCache is enabled
+		static int loadChunk(lua_State* L, const std::string& file);
 
 		static bool getArea(lua_State* L, std::vector<uint32_t>& vec, uint32_t& rows);
 
@@ -602,6 +625,8 @@ class LuaScriptInterface
 		static int luaGameIsDevMode(lua_State* L);
 		static int luaGameIsWindows(lua_State* L);
 
+		static int luaGameToggleLuaProfiler(lua_State* L);
+
 		// Variant
 		static int luaVariantCreate(lua_State* L);
 
@@ -961,6 +986,7 @@ class LuaScriptInterface
 
 		static int luaPlayerGetGuid(lua_State* L);
 		static int luaPlayerGetIp(lua_State* L);
+		static int luaPlayerGetSentBytes(lua_State* L);
 		static int luaPlayerGetAccountId(lua_State* L);
 		static int luaPlayerGetLastLoginSaved(lua_State* L);
 		static int luaPlayerGetLastLogout(lua_State* L);
@@ -438,11 +438,17 @@ void Map::getSpectators(SpectatorVec& spectators, const Position& centerPos, boo
 					}
 				} else {
 					const SpectatorVec& cachedSpectators = it->second;
+					SpectatorVec players;
+					SpectatorVec& result = spectators.empty() ? spectators : players;
 					for (Creature* spectator : cachedSpectators) {
 						if (spectator->getPlayer()) {
-							spectators.emplace_back(spectator);
+							result.emplace_back(spectator);
 						}
 					}
+
+					if (&result != &spectators) {
+						spectators.addSpectators(players);
+					}
 				}
 
 				foundCache = true;
@@ -476,18 +482,58 @@ void Map::getSpectators(SpectatorVec& spectators, const Position& centerPos, boo
 			maxRangeZ = centerPos.z;
 		}
 
-		getSpectatorsInternal(spectators, centerPos, minRangeX, maxRangeX, minRangeY, maxRangeY, minRangeZ, maxRangeZ, onlyPlayers);
+		//creatures the caller already collected must neither be repeated nor end up in the cache
+		SpectatorVec found;
+		SpectatorVec& result = spectators.empty() ? spectators : found;
+		getSpectatorsInternal(result, centerPos, minRangeX, maxRangeX, minRangeY, maxRangeY, minRangeZ, maxRangeZ, onlyPlayers);
 
 		if (cacheResult) {
 			if (onlyPlayers) {
-				playersSpectatorCache[centerPos] = spectators;
+				playersSpectatorCache[centerPos] = result;
 			} else {
-				spectatorCache[centerPos] = spectators;
+				spectatorCache[centerPos] = result;
 			}
 		}
+
+		if (&result != &spectators) {
+			spectators.addSpectators(found);
+		}
 	}
 }
 
+bool Map::isPlayerNearby(const Position& centerPos) const
+{
+	if (centerPos.z >= MAP_MAX_LAYERS) {
+		return false;
+	}
+
+	int32_t x1 = std::max<int32_t>(0, centerPos.x - maxViewportX);
+	int32_t y1 = std::max<int32_t>(0, centerPos.y - maxViewportY);
+	int32_t x2 = std::min<int32_t>(0xFFFF, centerPos.x + maxViewportX);
+	int32_t y2 = std::min<int32_t>(0xFFFF, centerPos.y + maxViewportY);
+
+	for (int32_t ny = y1 - (y1 % FLOOR_SIZE); ny <= y2; ny += FLOOR_SIZE) {
+		for (int32_t nx = x1 - (x1 % FLOOR_SIZE); nx <= x2; nx += FLOOR_SIZE) {
+			const QTreeLeafNode* leaf = QTreeNode::getLeafStatic<const QTreeLeafNode*, const QTreeNode*>(&root, nx, ny);
+			if (!leaf || leaf->player_list.empty()) {
+				continue;
+			}
+
+			for (Creature* creature : leaf->player_list) {
+				const Position& cpos = creature->getPosition();
+				if (cpos.z != centerPos.z || cpos.x < x1 || cpos.x > x2 || cpos.y < y1 || cpos.y > y2) {
+					continue;
+				}
+
+				if (!creature->getPlayer()->hasFlag(PlayerFlag_IgnoredByMonsters)) {
+					return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
 void Map::clearSpectatorCache()
 {
 	spectatorCache.clear();
@@ -508,6 +554,69 @@ bool Map::canThrowObjectTo(const Position& fromPos, const Position& toPos, bool
 	return !checkLineOfSight || isSightClear(fromPos, toPos, sameFloor);
 }
 
+template <typename Function>
+void Map::forEachTile(Function&& function) const
+{
+	std::vector<const QTreeNode*> nodes {&root};
+	while (!nodes.empty()) {
+		const QTreeNode* node = nodes.back();
+		nodes.pop_back();
+
+		if (!node->isLeaf()) {
+			for (const QTreeNode* child : node->child) {
+				if (child) {
+					nodes.push_back(child);
+				}
+			}
+			continue;
+		}
+
+		const QTreeLeafNode* leaf = static_cast<const QTreeLeafNode*>(node);
+		for (uint8_t z = 0; z < MAP_MAX_LAYERS; ++z) {
+			const Floor* floor = leaf->getFloor(z);
+			if (!floor) {
+				continue;
+			}
+
+			for (const auto& row : floor->tiles) {
+				for (Tile* tile : row) {
+					if (tile) {
+						function(tile);
+					}
+				}
+			}
+		}
+	}
+}
+
+size_t Map::verifyWalkFlags(size_t& tileCount) const
+{
+	constexpr size_t MAX_REPORTED = 10;
+
+	tileCount = 0;
+	size_t mismatches = 0;
+
+	forEachTile([&](const Tile* tile) {
+		++tileCount;
+		if (!tile->verifyWalkFlags()) {
+			if (++mismatches <= MAX_REPORTED) {
+				const Position& tilePos = tile->getPosition();
+				console::reportWarning(__FUNCTION__, fmt::format("Walk flags of the tile at position: {:d}, {:d}, {:d} do not match its items and creatures!", tilePos.x, tilePos.y, tilePos.z));
+			}
+		}
+	});
+	return mismatches;
+}
+
+void Map::refreshFieldFlags()
+{
+	forEachTile([](Tile* tile) {
+		if (tile->hasFlag(TILESTATE_MAGICFIELD)) {
+			tile->refreshFieldFlags();
+		}
+	});
+}
+
 bool Map::isTileClear(uint16_t x, uint16_t y, uint8_t z, bool blockFloor /*= false*/) const
 {
 	const Tile* tile = getTile(x, y, z);
@@ -946,7 +1055,7 @@ int_fast32_t AStarNodes::getMapWalkCost(AStarNode* node, const Position& neighbo
 int_fast32_t AStarNodes::getTileWalkCost(const Creature& creature, const Tile* tile)
 {
 	int_fast32_t cost = 0;
-	if (tile->getTopVisibleCreature(&creature)) {
+	if (tile->hasFlag(TILESTATE_CREATURES) && tile->getTopVisibleCreature(&creature)) {
 		//destroy creature cost
 		cost += MAP_NORMALWALKCOST * 3;
 	}
@@ -207,6 +207,12 @@ class Map
 		                   int32_t minRangeX = 0, int32_t maxRangeX = 0,
 		                   int32_t minRangeY = 0, int32_t maxRangeY = 0);
 
+		/**
+		  * Checks if a player not ignored by monsters is within the viewport of a position on the same floor.
+		  * Reads the player list of each quadtree leaf in range directly, so no spectator vector is built.
+		  */
+		bool isPlayerNearby(const Position& centerPos) const;
+
 		void clearSpectatorCache();
 		void clearPlayersSpectatorCache();
 
@@ -230,6 +236,19 @@ class Map
 		  */
 		bool isTileClear(uint16_t x, uint16_t y, uint8_t z, bool blockFloor = false) const;
 
+		/**
+		  * Checks the walk flags of every tile against its items and creatures
+		  *	\param tileCount set to the number of tiles checked
+		  *	\returns The number of tiles whose flags differ
+		  */
+		size_t verifyWalkFlags(size_t& tileCount) const;
+
+		/**
+		  * Sets the damaging field flag of every tile with a field again,
+		  * the damage of a field type can change when items are reloaded
+		  */
+		void refreshFieldFlags();
+
 		/**
 		  * Checks if path is clear from fromPos to toPos
 		  * Notice: This only checks a straight line if the path is clear, for path finding use getPathTo.
@@ -268,6 +287,9 @@ class Map
 		uint32_t width = 0;
 		uint32_t height = 0;
 
+		template <typename Function>
+		void forEachTile(Function&& function) const;
+
 		// Actually scans the map for spectators
 		void getSpectatorsInternal(SpectatorVec& spectators, const Position& centerPos,
 		                           int32_t minRangeX, int32_t maxRangeX,
@@ -0,0 +1,258 @@
+// Copyright 2022 The Forgotten Server Authors. All rights reserved.
+// Use of this source code is governed by the GPL-2.0 License that can be found in the LICENSE file.
+
+#include "otpch.h"
+
+#include "metrics.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace metrics {
+
+namespace {
+
+uint32_t getHighestBit(uint64_t value)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanReverse64(&index, value);
+	return index;
+#else
+	return 63 - __builtin_clzll(value);
+#endif
+}
+
+uint32_t getBucketIndex(uint64_t value)
+{
+	if (value < Histogram::SUB_BUCKETS) {
+		return static_cast<uint32_t>(value);
+	}
+
+	uint32_t exponent = getHighestBit(value);
+	if (exponent > Histogram::MAX_EXPONENT) {
+		return Histogram::BUCKET_COUNT - 1;
+	}
+
+	uint32_t subBucket = (value >> (exponent - Histogram::SUB_BUCKET_BITS)) & (Histogram::SUB_BUCKETS - 1);
+	return ((exponent - Histogram::SUB_BUCKET_BITS + 1) << Histogram::SUB_BUCKET_BITS) + subBucket;
+}
+
+std::string formatName(const std::string& name, const std::string& labels)
+{
+	if (labels.empty()) {
+		return name;
+	}
+	return fmt::format("{:s}{{{:s}}}", name, labels);
+}
+
+}
+
+void Histogram::observe(uint64_t microseconds)
+{
+	buckets[getBucketIndex(microseconds)].fetch_add(1, std::memory_order_relaxed);
+	count.fetch_add(1, std::memory_order_relaxed);
+	sum.fetch_add(microseconds, std::memory_order_relaxed);
+}
+
+uint64_t Histogram::getUpperBound(uint32_t bucket)
+{
+	uint32_t group = bucket >> SUB_BUCKET_BITS;
+	uint64_t subBucket = bucket & (SUB_BUCKETS - 1);
+	if (group == 0) {
+		return subBucket + 1;
+	}
+
+	uint32_t exponent = group + SUB_BUCKET_BITS - 1;
+	uint64_t width = static_cast<uint64_t>(1) << (exponent - SUB_BUCKET_BITS);
+	return (static_cast<uint64_t>(1) << exponent) + (subBucket + 1) * width;
+}
+
+uint64_t Histogram::getPercentile(const Buckets& buckets, double fraction)
+{
+	uint64_t total = 0;
+	for (uint64_t count : buckets) {
+		total += count;
+	}
+	if (total == 0) {
+		return 0;
+	}
+
+	const uint64_t target = std::max<uint64_t>(1, std::ceil(total * fraction));
+	uint64_t cumulative = 0;
+	for (uint32_t bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+		cumulative += buckets[bucket];
+		if (cumulative >= target) {
+			return getUpperBound(bucket);
+		}
+	}
+	return getUpperBound(BUCKET_COUNT - 1);
+}
+
+Histogram::Buckets Histogram::getBuckets() const
+{
+	Buckets result;
+	for (uint32_t bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+		result[bucket] = getBucket(bucket);
+	}
+	return result;
+}
+
+Registry::Family& Registry::getFamily(const std::string& name, const std::string& help, MetricType_t type)
+{
+	Family& family = families[name];
+	if (family.help.empty()) {
+		family.help = help;
+		family.type = type;
+	}
+	return family;
+}
+
+Counter& Registry::counter(const std::string& name, const std::string& help, const std::string& labels/* = ""*/)
+{
+	std::lock_guard<std::mutex> lockClass(registryLock);
+	auto& metric = getFamily(name, help, METRIC_COUNTER).counters[labels];
+	if (!metric) {
+		metric.reset(new Counter);
+	}
+	return *metric;
+}
+
+Gauge& Registry::gauge(const std::string& name, const std::string& help, const std::string& labels/* = ""*/)
+{
+	std::lock_guard<std::mutex> lockClass(registryLock);
+	auto& metric = getFamily(name, help, METRIC_GAUGE).gauges[labels];
+	if (!metric) {
+		metric.reset(new Gauge);
+	}
+	return *metric;
+}
+
+Histogram& Registry::histogram(const std::string& name, const std::string& help, const std::string& labels/* = ""*/)
+{
+	std::lock_guard<std::mutex> lockClass(registryLock);
+	auto& metric = getFamily(name, help, METRIC_HISTOGRAM).histograms[labels];
+	if (!metric) {
+		metric.reset(new Histogram);
+	}
+	return *metric;
+}
+
+std::string Registry::exportText() const
+{
+	std::lock_guard<std::mutex> lockClass(registryLock);
+
+	std::string out;
+	for (const auto& it : families) {
+		const std::string& name = it.first;
+		const Family& family = it.second;
+		switch (family.type) {
+			case METRIC_COUNTER: {
+				out += fmt::format("# HELP {:s} {:s}\n# TYPE {:s} counter\n", name, family.help, name);
+				for (const auto& metric : family.counters) {
+					out += fmt::format("{:s} {:d}\n", formatName(name, metric.first), metric.second->get());
+				}
+				break;
+			}
+
+			case METRIC_GAUGE: {
+				out += fmt::format("# HELP {:s} {:s}\n# TYPE {:s} gauge\n", name, family.help, name);
+				for (const auto& metric : family.gauges) {
+					out += fmt::format("{:s} {:d}\n", formatName(name, metric.first), metric.second->get());
+				}
+				break;
+			}
+
+			case METRIC_HISTOGRAM: {
+				out += fmt::format("# HELP {:s} {:s}\n# TYPE {:s} histogram\n", name, family.help, name);
+				for (const auto& metric : family.histograms) {
+					const std::string& labels = metric.first;
+					const Histogram& histogram = *metric.second;
+					const std::string separator = labels.empty() ? "" : ",";
+
+					//the total is taken from the buckets so the exported series stay consistent while being recorded
+					//le is inclusive, samples are whole microseconds below the exclusive bucket bound
+					uint64_t cumulative = 0;
+					for (uint32_t bucket = 0; bucket < Histogram::BUCKET_COUNT - 1; ++bucket) {
+						cumulative += histogram.getBucket(bucket);
+						out += fmt::format("{:s}_bucket{{{:s}{:s}le=\"{:.12g}\"}} {:d}\n", name, labels, separator, (Histogram::getUpperBound(bucket) - 1) / 1000000., cumulative);
+					}
+					cumulative += histogram.getBucket(Histogram::BUCKET_COUNT - 1);
+					out += fmt::format("{:s}_bucket{{{:s}{:s}le=\"+Inf\"}} {:d}\n", name, labels, separator, cumulative);
+					out += fmt::format("{:s} {:g}\n", formatName(name + "_sum", labels), histogram.getSum() / 1000000.);
+					out += fmt::format("{:s} {:d}\n", formatName(name + "_count", labels), cumulative);
+				}
+				break;
+			}
+		}
+	}
+	return out;
+}
+
+}
+
+bool MetricsServer::listen(uint16_t port)
+{
+	try {
+		acceptor.reset(new boost::asio::ip::tcp::acceptor(io_context, boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), port)));
+	} catch (boost::system::system_error& e) {
+		console::reportError("MetricsServer::listen", fmt::format("Can't bind metrics port {:d}: {:s}", port, e.what()));
+		return false;
+	}
+
+	accept();
+	return true;
+}
+
+void MetricsServer::accept()
+{
+	auto socket = std::make_shared<boost::asio::ip::tcp::socket>(io_context);
+	acceptor->async_accept(*socket, [this, socket](const boost::system::error_code& error) {
+		if (error) {
+			if (error != boost::asio::error::operation_aborted) {
+				accept();
+			}
+			return;
+		}
+
+		auto request = std::make_shared<boost::asio::streambuf>(8192);
+		boost::asio::async_read_until(*socket, *request, "\r\n\r\n", [socket, request](const boost::system::error_code& error, size_t /*bytes_transferred*/) {
+			if (error) {
+				return;
+			}
+
+			std::istream stream(request.get());
+			std::string method, path;
+			stream >> method >> path;
+
+			auto response = std::make_shared<std::string>();
+			if (method == "GET" && (path == "/metrics" || path == "/")) {
+				std::string body = metrics::Registry::getInstance().exportText();
+				*response = fmt::format("HTTP/1.1 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: {:d}\r\nConnection: close\r\n\r\n{:s}", body.size(), body);
+			} else {
+				*response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+			}
+
+			boost::asio::async_write(*socket, boost::asio::buffer(*response), [socket, response](const boost::system::error_code& /*error*/, size_t /*bytes_transferred*/) {
+				boost::system::error_code ignored;
+				socket->shutdown(boost::asio::ip::tcp::socket::shutdown_both, ignored);
+				socket->close(ignored);
+			});
+		});
+
+		accept();
+	});
+}
+
+void MetricsServer::shutdown()
+{
+	setState(THREAD_STATE_TERMINATED);
+	boost::asio::post(io_context, [this]() {
+		if (acceptor) {
+			boost::system::error_code error;
+			acceptor->close(error);
+		}
+		io_context.stop();
+	});
+}
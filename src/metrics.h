@@ -0,0 +1,168 @@
+// Copyright 2022 The Forgotten Server Authors. All rights reserved.
+// Use of this source code is governed by the GPL-2.0 License that can be found in the LICENSE file.
+
+#ifndef FS_METRICS_H
+#define FS_METRICS_H
+
+#include "thread_holder_base.h"
+
+/*
+ * always-on runtime metrics, recording is a relaxed atomic update so it can
+ * stay enabled in production; metrics are registered once (usually when the
+ * owning object is created) and the returned references stay valid for the
+ * lifetime of the process
+ */
+namespace metrics {
+
+class Counter
+{
+	public:
+		void increment(uint64_t value = 1) {
+			count.fetch_add(value, std::memory_order_relaxed);
+		}
+
+		uint64_t get() const {
+			return count.load(std::memory_order_relaxed);
+		}
+
+	private:
+		std::atomic<uint64_t> count {0};
+};
+
+class Gauge
+{
+	public:
+		void set(int64_t newValue) {
+			value.store(newValue, std::memory_order_relaxed);
+		}
+		void add(int64_t delta) {
+			value.fetch_add(delta, std::memory_order_relaxed);
+		}
+
+		int64_t get() const {
+			return value.load(std::memory_order_relaxed);
+		}
+
+	private:
+		std::atomic<int64_t> value {0};
+};
+
+// log-linear buckets over microseconds: every power of two is split in 2^SUB_BUCKET_BITS buckets
+class Histogram
+{
+	public:
+		static constexpr uint32_t SUB_BUCKET_BITS = 2;
+		static constexpr uint32_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+		static constexpr uint32_t MAX_EXPONENT = 32; // about 71 minutes
+		static constexpr uint32_t BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 2) * SUB_BUCKETS;
+
+		void observe(uint64_t microseconds);
+		void observe(std::chrono::nanoseconds duration) {
+			observe(static_cast<uint64_t>(duration.count()) / 1000);
+		}
+
+		using Buckets = std::array<uint64_t, BUCKET_COUNT>;
+
+		// exclusive upper bound of a bucket in microseconds
+		static uint64_t getUpperBound(uint32_t bucket);
+		// upper bound of the bucket that holds the given fraction of the samples
+		static uint64_t getPercentile(const Buckets& buckets, double fraction);
+
+		Buckets getBuckets() const;
+
+		uint64_t getBucket(uint32_t bucket) const {
+			return buckets[bucket].load(std::memory_order_relaxed);
+		}
+		uint64_t getCount() const {
+			return count.load(std::memory_order_relaxed);
+		}
+		uint64_t getSum() const {
+			return sum.load(std::memory_order_relaxed);
+		}
+
+	private:
+		std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets {};
+		std::atomic<uint64_t> count {0};
+		std::atomic<uint64_t> sum {0};
+};
+
+// measures the scope it lives in
+class ScopedTimer
+{
+	public:
+		explicit ScopedTimer(Histogram& histogram) : histogram(histogram), start(std::chrono::steady_clock::now()) {}
+		~ScopedTimer() {
+			histogram.observe(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+		}
+
+		// non-copyable
+		ScopedTimer(const ScopedTimer&) = delete;
+		ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+	private:
+		Histogram& histogram;
+		std::chrono::steady_clock::time_point start;
+};
+
+class Registry
+{
+	public:
+		static Registry& getInstance() {
+			static Registry instance;
+			return instance;
+		}
+
+		// labels are given in exposition format, e.g. dispatcher="0"
+		Counter& counter(const std::string& name, const std::string& help, const std::string& labels = "");
+		Gauge& gauge(const std::string& name, const std::string& help, const std::string& labels = "");
+		Histogram& histogram(const std::string& name, const std::string& help, const std::string& labels = "");
+
+		// Prometheus text exposition format
+		std::string exportText() const;
+
+	private:
+		Registry() = default;
+
+		enum MetricType_t {
+			METRIC_COUNTER,
+			METRIC_GAUGE,
+			METRIC_HISTOGRAM,
+		};
+
+		struct Family {
+			std::string help;
+			MetricType_t type;
+			std::map<std::string, std::unique_ptr<Counter>> counters;
+			std::map<std::string, std::unique_ptr<Gauge>> gauges;
+			std::map<std::string, std::unique_ptr<Histogram>> histograms;
+		};
+
+		Family& getFamily(const std::string& name, const std::string& help, MetricType_t type);
+
+		std::map<std::string, Family> families;
+		mutable std::mutex registryLock;
+};
+
+}
+
+// serves the registry over plain HTTP on a local port for Prometheus to scrape
+class MetricsServer : public ThreadHolder<MetricsServer>
+{
+	public:
+		bool listen(uint16_t port);
+		void shutdown();
+
+		void threadMain() {
+			io_context.run();
+		}
+
+	private:
+		void accept();
+
+		boost::asio::io_context io_context;
+		std::unique_ptr<boost::asio::ip::tcp::acceptor> acceptor;
+};
+
+extern MetricsServer g_metricsServer;
+
+#endif
@@ -67,6 +67,32 @@ bool Monsters::loadFromXml(bool reloading /*= false*/)
 	return true;
 }
 
+void Monsters::stageMonsterTypes(const std::vector<std::string>& names)
+{
+	std::vector<std::string> fileNames;
+	for (const std::string& name : names) {
+		std::string lowerCaseName = asLowerCaseString(name);
+		if (monsters.find(lowerCaseName) != monsters.end()) {
+			continue;
+		}
+
+		auto it = unloadedMonsters.find(lowerCaseName);
+		if (it != unloadedMonsters.end() && stagedDocuments.find(it->second) == stagedDocuments.end()) {
+			fileNames.push_back(it->second);
+		}
+	}
+
+	std::sort(fileNames.begin(), fileNames.end());
+	fileNames.erase(std::unique(fileNames.begin(), fileNames.end()), fileNames.end());
+
+	//failed parses are left out, loadMonster reads the file again and reports the error
+	for (XmlDocumentResult& entry : loadXmlDocuments(fileNames)) {
+		if (entry.result) {
+			stagedDocuments.emplace(std::move(entry.fileName), std::move(entry.document));
+		}
+	}
+}
+
 bool Monsters::reload()
 {
 	loaded = false;
@@ -771,14 +797,21 @@ MonsterType* Monsters::loadMonster(const std::string& file, const std::string& m
 
 	const std::string location = "Monsters::loadMonster";
 
-	pugi::xml_document doc;
-	pugi::xml_parse_result result = doc.load_file(file.c_str());
-	if (!result) {
-		printXMLError(location, file, result);
-		return nullptr;
+	std::shared_ptr<pugi::xml_document> doc;
+	auto it = stagedDocuments.find(file);
+	if (it != stagedDocuments.end()) {
+		doc = std::move(it->second);
+		stagedDocuments.erase(it);
+	} else {
+		doc = std::make_shared<pugi::xml_document>();
+		pugi::xml_parse_result result = doc->load_file(file.c_str());
+		if (!result) {
+			printXMLError(location, file, result);
+			return nullptr;
+		}
 	}
 
-	pugi::xml_node monsterNode = doc.child("monster");
+	pugi::xml_node monsterNode = doc->child("monster");
 	if (!monsterNode) {
 		console::reportError(location, "Missing monster node in \"" + file + "\"!");
 		return nullptr;
@@ -1371,14 +1404,19 @@ bool MonsterType::loadCallback(LuaScriptInterface* scriptInterface)
 	info.scriptInterface = scriptInterface;
 	if (info.eventType == MONSTERS_EVENT_THINK) {
 		info.thinkEvent = id;
+		scriptInterface->setEventName(id, "onThink");
 	} else if (info.eventType == MONSTERS_EVENT_APPEAR) {
 		info.creatureAppearEvent = id;
+		scriptInterface->setEventName(id, "onCreatureAppear");
 	} else if (info.eventType == MONSTERS_EVENT_DISAPPEAR) {
 		info.creatureDisappearEvent = id;
+		scriptInterface->setEventName(id, "onCreatureDisappear");
 	} else if (info.eventType == MONSTERS_EVENT_MOVE) {
 		info.creatureMoveEvent = id;
+		scriptInterface->setEventName(id, "onCreatureMove");
 	} else if (info.eventType == MONSTERS_EVENT_SAY) {
 		info.creatureSayEvent = id;
+		scriptInterface->setEventName(id, "onCreatureSay");
 	}
 	return true;
 }
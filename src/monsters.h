@@ -234,6 +234,12 @@ class Monsters
 		MonsterType* getMonsterType(const std::string& name, bool loadFromFile = true);
 		bool deserializeSpell(MonsterSpell* spell, spellBlock_t& sb, const std::string& description = "");
 
+		//parses the xml files of the given, not yet loaded, monster types ahead of time
+		void stageMonsterTypes(const std::vector<std::string>& names);
+		void clearStagedDocuments() {
+			stagedDocuments.clear();
+		}
+
 		std::unique_ptr<LuaScriptInterface> scriptInterface;
 		std::map<std::string, MonsterType> monsters;
 
@@ -248,6 +254,7 @@ class Monsters
 		bool loadLootItem(const pugi::xml_node& node, LootBlock&);
 
 		std::map<std::string, std::string> unloadedMonsters;
+		std::map<std::string, std::shared_ptr<pugi::xml_document>> stagedDocuments;
 
 		bool loaded = false;
 };
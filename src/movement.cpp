@@ -39,6 +39,33 @@ void MoveEvents::clearMap(MoveListMap& map, bool fromLua)
 	}
 }
 
+void MoveEvents::clearMap(MoveItemIdList& list, bool fromLua)
+{
+	for (auto& moveEventList : list) {
+		if (!moveEventList) {
+			continue;
+		}
+
+		bool empty = true;
+		for (int eventType = MOVE_EVENT_STEP_IN; eventType < MOVE_EVENT_LAST; ++eventType) {
+			auto& moveEvents = moveEventList->moveEvent[eventType];
+			for (auto find = moveEvents.begin(); find != moveEvents.end(); ) {
+				if (fromLua == find->fromLua) {
+					find = moveEvents.erase(find);
+				} else {
+					++find;
+				}
+			}
+			empty = empty && moveEvents.empty();
+		}
+
+		//item ids without events go back to the fast path
+		if (empty) {
+			moveEventList.reset();
+		}
+	}
+}
+
 void MoveEvents::clearPosMap(MovePosListMap& map, bool fromLua)
 {
 	for (auto it = map.begin(); it != map.end(); ++it) {
@@ -334,6 +361,31 @@ void MoveEvents::addEvent(MoveEvent moveEvent, int32_t id, MoveListMap& map)
 	}
 }
 
+void MoveEvents::addEvent(MoveEvent moveEvent, int32_t id, MoveItemIdList& list)
+{
+	if (id <= 0 || id > std::numeric_limits<uint16_t>::max()) {
+		console::reportWarning("MoveEvents::addEvent", "Invalid item id: " + std::to_string(id) + "!");
+		return;
+	}
+
+	if (static_cast<size_t>(id) >= list.size()) {
+		list.resize(id + 1);
+	}
+
+	auto& moveEventList = list[id];
+	if (!moveEventList) {
+		moveEventList.reset(new MoveEventList);
+	}
+
+	std::list<MoveEvent>& moveEvents = moveEventList->moveEvent[moveEvent.getEventType()];
+	for (MoveEvent& existingMoveEvent : moveEvents) {
+		if (existingMoveEvent.getSlot() == moveEvent.getSlot()) {
+			console::reportWarning("MoveEvents::addEvent", "Duplicate event id: " + std::to_string(id) + "!");
+		}
+	}
+	moveEvents.push_back(std::move(moveEvent));
+}
+
 MoveEvent* MoveEvents::getEvent(Item* item, MoveEvent_t eventType, slots_t slot)
 {
 	uint32_t slotp;
@@ -351,9 +403,9 @@ MoveEvent* MoveEvents::getEvent(Item* item, MoveEvent_t eventType, slots_t slot)
 		default: slotp = 0; break;
 	}
 
-	auto it = itemIdMap.find(item->getID());
-	if (it != itemIdMap.end()) {
-		std::list<MoveEvent>& moveEventList = it->second.moveEvent[eventType];
+	MoveEventList* itemIdEvents = getItemIdEvents(item->getID());
+	if (itemIdEvents) {
+		std::list<MoveEvent>& moveEventList = itemIdEvents->moveEvent[eventType];
 		for (MoveEvent& moveEvent : moveEventList) {
 			if ((moveEvent.getSlot() & slotp) != 0) {
 				return &moveEvent;
@@ -367,7 +419,7 @@ MoveEvent* MoveEvents::getEvent(Item* item, MoveEvent_t eventType)
 {
 	MoveListMap::iterator it;
 
-	if (item->hasAttribute(ITEM_ATTRIBUTE_UNIQUEID)) {
+	if (item->hasAttribute(ITEM_ATTRIBUTE_UNIQUEID) && !uniqueIdMap.empty()) {
 		it = uniqueIdMap.find(item->getUniqueId());
 		if (it != uniqueIdMap.end()) {
 			std::list<MoveEvent>& moveEventList = it->second.moveEvent[eventType];
@@ -377,7 +429,7 @@ MoveEvent* MoveEvents::getEvent(Item* item, MoveEvent_t eventType)
 		}
 	}
 
-	if (item->hasAttribute(ITEM_ATTRIBUTE_ACTIONID)) {
+	if (item->hasAttribute(ITEM_ATTRIBUTE_ACTIONID) && !actionIdMap.empty()) {
 		it = actionIdMap.find(item->getActionId());
 		if (it != actionIdMap.end()) {
 			std::list<MoveEvent>& moveEventList = it->second.moveEvent[eventType];
@@ -387,9 +439,9 @@ MoveEvent* MoveEvents::getEvent(Item* item, MoveEvent_t eventType)
 		}
 	}
 
-	it = itemIdMap.find(item->getID());
-	if (it != itemIdMap.end()) {
-		std::list<MoveEvent>& moveEventList = it->second.moveEvent[eventType];
+	MoveEventList* itemIdEvents = getItemIdEvents(item->getID());
+	if (itemIdEvents) {
+		std::list<MoveEvent>& moveEventList = itemIdEvents->moveEvent[eventType];
 		if (!moveEventList.empty()) {
 			return &(*moveEventList.begin());
 		}
@@ -418,6 +470,10 @@ void MoveEvents::addEvent(MoveEvent moveEvent, const Position& pos, MovePosListM
 
 MoveEvent* MoveEvents::getEvent(const Tile* tile, MoveEvent_t eventType)
 {
+	if (positionMap.empty()) {
+		return nullptr;
+	}
+
 	auto it = positionMap.find(tile->getPosition());
 	if (it != positionMap.end()) {
 		std::list<MoveEvent>& moveEventList = it->second.moveEvent[eventType];
@@ -1024,8 +1080,7 @@ bool MoveEvent::executeEquip(Player* player, Item* item, slots_t slot, bool isCh
 	lua_State* L = scriptInterface->getLuaState();
 
 	scriptInterface->pushFunction(scriptId);
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 	LuaScriptInterface::pushThing(L, item);
 	lua_pushnumber(L, slot);
 	LuaScriptInterface::pushBoolean(L, isCheck);
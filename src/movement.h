@@ -57,9 +57,12 @@ class MoveEvents final : public BaseEvents
 		void clear(bool fromLua) override final;
 
 	private:
-		using MoveListMap = std::map<int32_t, MoveEventList>;
-		using MovePosListMap = std::map<Position, MoveEventList>;
+		using MoveListMap = std::unordered_map<int32_t, MoveEventList>;
+		using MovePosListMap = std::unordered_map<Position, MoveEventList>;
+		//indexed by item id, most ids have no events so the lists are allocated on demand
+		using MoveItemIdList = std::vector<std::unique_ptr<MoveEventList>>;
 		void clearMap(MoveListMap& map, bool fromLua);
+		void clearMap(MoveItemIdList& list, bool fromLua);
 		void clearPosMap(MovePosListMap& map, bool fromLua);
 
 		LuaScriptInterface& getScriptInterface() override;
@@ -68,6 +71,10 @@ class MoveEvents final : public BaseEvents
 		bool registerEvent(Event_ptr event, const pugi::xml_node& node) override;
 
 		void addEvent(MoveEvent moveEvent, int32_t id, MoveListMap& map);
+		void addEvent(MoveEvent moveEvent, int32_t id, MoveItemIdList& list);
+		MoveEventList* getItemIdEvents(uint16_t id) {
+			return id < itemIdMap.size() ? itemIdMap[id].get() : nullptr;
+		}
 
 		void addEvent(MoveEvent moveEvent, const Position& pos, MovePosListMap& map);
 		MoveEvent* getEvent(const Tile* tile, MoveEvent_t eventType);
@@ -76,7 +83,7 @@ class MoveEvents final : public BaseEvents
 
 		MoveListMap uniqueIdMap;
 		MoveListMap actionIdMap;
-		MoveListMap itemIdMap;
+		MoveItemIdList itemIdMap;
 		MovePosListMap positionMap;
 
 		LuaScriptInterface scriptInterface;
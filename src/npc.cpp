@@ -14,6 +14,7 @@ extern LuaEnvironment g_luaEnvironment;
 
 uint32_t Npc::npcAutoID = 0x20000000;
 NpcScriptInterface* Npc::scriptInterface = nullptr;
+std::map<std::string, std::shared_ptr<pugi::xml_document>> Npc::stagedDocuments;
 
 void Npcs::reload()
 {
@@ -39,6 +40,33 @@ Npc* Npc::createNpc(const std::string& name)
 	return npc.release();
 }
 
+void Npc::stageDocuments(const std::vector<std::string>& names)
+{
+	std::vector<std::string> fileNames;
+	fileNames.reserve(names.size());
+	for (const std::string& name : names) {
+		std::string fileName = "data/npc/" + name + ".xml";
+		if (stagedDocuments.find(fileName) == stagedDocuments.end()) {
+			fileNames.push_back(std::move(fileName));
+		}
+	}
+
+	std::sort(fileNames.begin(), fileNames.end());
+	fileNames.erase(std::unique(fileNames.begin(), fileNames.end()), fileNames.end());
+
+	//failed parses are left out, loadFromXml reads the file again and reports the error
+	for (XmlDocumentResult& entry : loadXmlDocuments(fileNames)) {
+		if (entry.result) {
+			stagedDocuments.emplace(std::move(entry.fileName), std::move(entry.document));
+		}
+	}
+}
+
+void Npc::clearStagedDocuments()
+{
+	stagedDocuments.clear();
+}
+
 Npc::Npc(const std::string& name) :
 	Creature(),
 	filename("data/npc/" + name + ".xml"),
@@ -130,14 +158,20 @@ void Npc::reload()
 
 bool Npc::loadFromXml()
 {
-	pugi::xml_document doc;
-	pugi::xml_parse_result result = doc.load_file(filename.c_str());
-	if (!result) {
-		printXMLError("Npc::loadFromXml", filename, result);
-		return false;
+	std::shared_ptr<pugi::xml_document> doc;
+	auto it = stagedDocuments.find(filename);
+	if (it != stagedDocuments.end()) {
+		doc = it->second;
+	} else {
+		doc = std::make_shared<pugi::xml_document>();
+		pugi::xml_parse_result result = doc->load_file(filename.c_str());
+		if (!result) {
+			printXMLError("Npc::loadFromXml", filename, result);
+			return false;
+		}
 	}
 
-	pugi::xml_node npcNode = doc.child("npc");
+	pugi::xml_node npcNode = doc->child("npc");
 	if (!npcNode) {
 		console::reportFileError("Npc::loadFromXml", filename, "Missing npc tag!");
 		return false;
@@ -1256,8 +1290,7 @@ void NpcEventsHandler::onPlayerTrade(Player* player, int32_t callback, uint16_t
 
 	lua_State* L = scriptInterface->getLuaState();
 	LuaScriptInterface::pushCallback(L, callback);
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 	lua_pushnumber(L, itemId);
 	lua_pushnumber(L, subType);
 	lua_pushnumber(L, amount);
@@ -1284,8 +1317,7 @@ void NpcEventsHandler::onPlayerCloseChannel(Player* player)
 
 	lua_State* L = scriptInterface->getLuaState();
 	scriptInterface->pushFunction(playerCloseChannelEvent);
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 	scriptInterface->callFunction(1);
 }
 
@@ -1307,8 +1339,7 @@ void NpcEventsHandler::onPlayerEndTrade(Player* player)
 
 	lua_State* L = scriptInterface->getLuaState();
 	scriptInterface->pushFunction(playerEndTradeEvent);
-	LuaScriptInterface::pushUserdata<Player>(L, player);
-	LuaScriptInterface::setMetatable(L, -1, "Player");
+	LuaScriptInterface::pushUserdata<Player>(L, player, LuaData_Player);
 	scriptInterface->callFunction(1);
 }
 
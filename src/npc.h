@@ -114,6 +114,10 @@ class Npc final : public Creature
 
 		static Npc* createNpc(const std::string& name);
 
+		//parses the xml files of the given npcs ahead of time, instances created afterwards share them
+		static void stageDocuments(const std::vector<std::string>& names);
+		static void clearStagedDocuments();
+
 		bool canSee(const Position& pos) const override;
 
 		bool load();
@@ -246,6 +250,7 @@ class Npc final : public Creature
 		bool pushable;
 
 		static NpcScriptInterface* scriptInterface;
+		static std::map<std::string, std::shared_ptr<pugi::xml_document>> stagedDocuments;
 
 		friend class Npcs;
 		friend class NpcScriptInterface;
@@ -0,0 +1,170 @@
+// Copyright 2022 The Forgotten Server Authors. All rights reserved.
+// Use of this source code is governed by the GPL-2.0 License that can be found in the LICENSE file.
+
+#include "otpch.h"
+
+#include "objectpool.h"
+#include "lockfree.h"
+
+namespace {
+
+constexpr size_t MAX_BLOCK_SIZE = ObjectPool::GRANULARITY * ObjectPool::CLASS_COUNT;
+
+using FreeList = boost::lockfree::stack<void*, boost::lockfree::capacity<ObjectPool::FREE_LIST_CAPACITY>>;
+
+template <size_t... Index>
+std::array<FreeList*, sizeof...(Index)> makeFreeLists(std::index_sequence<Index...>)
+{
+	return {{&LockfreeFreeList<(Index + 1) * ObjectPool::GRANULARITY, ObjectPool::FREE_LIST_CAPACITY>::get()...}};
+}
+
+FreeList& getFreeList(size_t index)
+{
+	static const auto freeLists = makeFreeLists(std::make_index_sequence<ObjectPool::CLASS_COUNT>());
+	return *freeLists[index];
+}
+
+void release(FreeList& freeList, void* p)
+{
+	if (!freeList.bounded_push(p)) {
+		operator delete(p);
+	}
+}
+
+struct ClassCounters {
+	std::atomic<uint64_t> live {0};
+	std::atomic<uint64_t> allocations {0};
+	std::atomic<uint64_t> heapAllocations {0};
+};
+
+std::array<ClassCounters, ObjectPool::CLASS_COUNT> counters;
+
+struct TypeCounters {
+	std::atomic<uint64_t> live {0};
+	std::atomic<uint64_t> allocations {0};
+};
+
+std::array<TypeCounters, POOLED_LAST + 1> typeCounters;
+
+constexpr std::array<const char*, POOLED_LAST + 1> typeNames {{"Item", "Container", "Teleport", "MagicField", "ItemAttributes"}};
+
+struct ThreadCache {
+	~ThreadCache();
+
+	std::array<std::array<void*, ObjectPool::THREAD_CACHE_CAPACITY>, ObjectPool::CLASS_COUNT> blocks;
+	std::array<size_t, ObjectPool::CLASS_COUNT> counts {};
+};
+
+//objects released during thread (or program) teardown skip the cache once it is gone
+thread_local bool threadCacheDestroyed = false;
+thread_local ThreadCache threadCache;
+
+ThreadCache::~ThreadCache()
+{
+	threadCacheDestroyed = true;
+	for (size_t index = 0; index < ObjectPool::CLASS_COUNT; ++index) {
+		FreeList& freeList = getFreeList(index);
+		for (size_t i = 0; i < counts[index]; ++i) {
+			release(freeList, blocks[index][i]);
+		}
+		counts[index] = 0;
+	}
+}
+
+}
+
+void* ObjectPool::allocate(size_t size, PooledType_t type)
+{
+	TypeCounters& pooledType = typeCounters[type];
+	pooledType.live.fetch_add(1, std::memory_order_relaxed);
+	pooledType.allocations.fetch_add(1, std::memory_order_relaxed);
+
+	if (size == 0 || size > MAX_BLOCK_SIZE) {
+		return operator new(size);
+	}
+
+	const size_t index = (size - 1) / GRANULARITY;
+	ClassCounters& classCounters = counters[index];
+	classCounters.live.fetch_add(1, std::memory_order_relaxed);
+	classCounters.allocations.fetch_add(1, std::memory_order_relaxed);
+
+	if (!threadCacheDestroyed) {
+		ThreadCache& cache = threadCache;
+		if (cache.counts[index] != 0) {
+			return cache.blocks[index][--cache.counts[index]];
+		}
+	}
+
+	void* p;
+	if (getFreeList(index).pop(p)) {
+		return p;
+	}
+
+	classCounters.heapAllocations.fetch_add(1, std::memory_order_relaxed);
+	return operator new((index + 1) * GRANULARITY);
+}
+
+void ObjectPool::deallocate(void* p, size_t size, PooledType_t type)
+{
+	if (!p) {
+		return;
+	}
+
+	typeCounters[type].live.fetch_sub(1, std::memory_order_relaxed);
+
+	if (size == 0 || size > MAX_BLOCK_SIZE) {
+		operator delete(p);
+		return;
+	}
+
+	const size_t index = (size - 1) / GRANULARITY;
+	counters[index].live.fetch_sub(1, std::memory_order_relaxed);
+
+	if (threadCacheDestroyed) {
+		release(getFreeList(index), p);
+		return;
+	}
+
+	ThreadCache& cache = threadCache;
+	size_t& count = cache.counts[index];
+	if (count == THREAD_CACHE_CAPACITY) {
+		//hand half of the cache over so blocks released here can be reused by other threads
+		FreeList& freeList = getFreeList(index);
+		for (size_t i = THREAD_CACHE_CAPACITY / 2; i < THREAD_CACHE_CAPACITY; ++i) {
+			release(freeList, cache.blocks[index][i]);
+		}
+		count = THREAD_CACHE_CAPACITY / 2;
+	}
+	cache.blocks[index][count++] = p;
+}
+
+std::vector<ObjectPool::ClassStats> ObjectPool::getStats()
+{
+	std::vector<ClassStats> stats;
+	stats.reserve(CLASS_COUNT);
+	for (size_t index = 0; index < CLASS_COUNT; ++index) {
+		const ClassCounters& classCounters = counters[index];
+		stats.push_back({
+			(index + 1) * GRANULARITY,
+			classCounters.live.load(std::memory_order_relaxed),
+			classCounters.allocations.load(std::memory_order_relaxed),
+			classCounters.heapAllocations.load(std::memory_order_relaxed)
+		});
+	}
+	return stats;
+}
+
+std::vector<ObjectPool::TypeStats> ObjectPool::getTypeStats()
+{
+	std::vector<TypeStats> stats;
+	stats.reserve(typeCounters.size());
+	for (size_t type = 0; type < typeCounters.size(); ++type) {
+		const TypeCounters& pooledType = typeCounters[type];
+		stats.push_back({
+			typeNames[type],
+			pooledType.live.load(std::memory_order_relaxed),
+			pooledType.allocations.load(std::memory_order_relaxed)
+		});
+	}
+	return stats;
+}
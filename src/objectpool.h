@@ -0,0 +1,52 @@
+// Copyright 2022 The Forgotten Server Authors. All rights reserved.
+// Use of this source code is governed by the GPL-2.0 License that can be found in the LICENSE file.
+
+#ifndef FS_OBJECTPOOL_H
+#define FS_OBJECTPOOL_H
+
+// object types the pool keeps live counts for, subclasses count as their pooled base
+enum PooledType_t : uint8_t {
+	POOLED_ITEM,
+	POOLED_CONTAINER,
+	POOLED_TELEPORT,
+	POOLED_MAGICFIELD,
+	POOLED_ITEMATTRIBUTES,
+
+	POOLED_LAST = POOLED_ITEMATTRIBUTES
+};
+
+/*
+ * size-class pools for objects that are created and released all the time
+ * (items and their attributes), released blocks are kept for reuse instead
+ * of going back to the heap: first in a small per-thread cache, then in a
+ * lock-free list shared by all threads
+ */
+class ObjectPool
+{
+	public:
+		static constexpr size_t GRANULARITY = 16;
+		static constexpr size_t CLASS_COUNT = 32; // blocks up to 512 bytes
+		static constexpr size_t FREE_LIST_CAPACITY = 4096;
+		static constexpr size_t THREAD_CACHE_CAPACITY = 128;
+
+		struct ClassStats {
+			size_t blockSize;
+			uint64_t live;
+			uint64_t allocations;
+			uint64_t heapAllocations;
+		};
+
+		struct TypeStats {
+			const char* name;
+			uint64_t live;
+			uint64_t allocations;
+		};
+
+		static void* allocate(size_t size, PooledType_t type);
+		static void deallocate(void* p, size_t size, PooledType_t type);
+
+		static std::vector<ClassStats> getStats();
+		static std::vector<TypeStats> getTypeStats();
+};
+
+#endif
@@ -13,14 +13,17 @@
 #include <atomic>
 #include <bitset>
 #include <boost/asio.hpp>
+#include <boost/container/small_vector.hpp>
 #include <boost/iostreams/device/mapped_file.hpp>
 #include <boost/lockfree/stack.hpp>
 #include <boost/variant.hpp>
 #include <cassert>
+#include <charconv>
 #include <cmath>
 #include <condition_variable>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <deque>
 #include <fmt/color.h>
 #include <forward_list>
@@ -34,6 +37,7 @@
 #include <mutex>
 #include <mysql/mysql.h>
 #include <pugixml.hpp>
+#include <queue>
 #include <random>
 #include <set>
 #include <sstream>
@@ -9,8 +9,11 @@
 #include "game.h"
 #include "imbuing.h"
 #include "iomarket.h"
+#include "metrics.h"
 #include "monsters.h"
 #include "outfit.h"
+#include "packetrecord.h"
+#include "playernamecache.h"
 #include "protocollogin.h"
 #include "protocolold.h"
 #include "protocolstatus.h"
@@ -21,6 +24,7 @@
 #include "server.h"
 
 #include <fstream>
+#include <future>
 #include <iomanip>
 
 #if __has_include("gitmetadata.h")
@@ -29,6 +33,7 @@
 
 DatabaseTasks g_databaseTasks;
 Dispatcher g_dispatcher;
+MetricsServer g_metricsServer;
 Scheduler g_scheduler;
 Stats g_stats;
 
@@ -50,6 +55,30 @@ void startupErrorMessage(const std::string& errorStr)
 	g_loaderSignal.notify_all();
 }
 
+//collects how long each startup phase took, printed once the server is up
+class StartupTimer
+{
+	public:
+		void mark(std::string phase) {
+			int64_t now = OTSYS_TIME();
+			phases.emplace_back(std::move(phase), now - last);
+			last = now;
+		}
+
+		void print() const {
+			console::print(CONSOLEMESSAGE_TYPE_STARTUP, "");
+			for (const auto& it : phases) {
+				console::printWorldInfo(it.first, fmt::format("{:d} ms", it.second));
+			}
+			console::printWorldInfo("Total", fmt::format("{:d} ms", last - start));
+		}
+
+	private:
+		std::vector<std::pair<std::string, int64_t>> phases;
+		int64_t start = OTSYS_TIME();
+		int64_t last = start;
+};
+
 void mainLoader(int argc, char* argv[], ServiceManager* services);
 bool argumentsHandler(const StringVector& args);
 
@@ -104,6 +133,9 @@ int main(int argc, char* argv[])
 	g_databaseTasks.join();
 	g_dispatcher.join();
 	g_stats.join();
+	g_metricsServer.join();
+	PacketReplay::getInstance().join();
+	PacketRecorder::getInstance().close();
 	return 0;
 }
 
@@ -171,6 +203,8 @@ void mainLoader(int, char*[], ServiceManager* services)
 	// The Forgotten Server (version)
 	printServerVersion();
 
+	StartupTimer startupTimer;
+
 	// Loading config.lua ...
 	const std::string& configFile = g_config.getString(ConfigManager::CONFIG_FILE);
 	const std::string& distFile = configFile + ".dist";
@@ -221,6 +255,8 @@ void mainLoader(int, char*[], ServiceManager* services)
 #endif
 
 
+	startupTimer.mark("Config");
+
 	// set RSA key
 	console::print(CONSOLEMESSAGE_TYPE_STARTUP, "Loading RSA key ... ", false);
 	try {
@@ -231,6 +267,7 @@ void mainLoader(int, char*[], ServiceManager* services)
 		return;
 	}
 	console::printResult(CONSOLE_LOADING_OK);
+	startupTimer.mark("RSA key");
 
 
 	// connect to the database
@@ -264,6 +301,15 @@ void mainLoader(int, char*[], ServiceManager* services)
 	// Checking database migrations...
 	DatabaseManager::updateDatabase();
 
+	// player name cache
+	PlayerNameCache& playerNameCache = PlayerNameCache::getInstance();
+	playerNameCache.setCapacity(std::max<int32_t>(0, g_config.getNumber(ConfigManager::PLAYER_NAME_CACHE_SIZE)));
+	if (g_config.getBoolean(ConfigManager::PLAYER_NAME_CACHE_PRELOAD)) {
+		console::print(CONSOLEMESSAGE_TYPE_STARTUP, "Loading player names ... ", false);
+		const size_t loaded = playerNameCache.preload(Database::getInstance());
+		console::printResultText(fmt::format("{:d} players", loaded));
+	}
+
 	// load autonumering for loot containers
 	g_game.loadLatestLootContainerId();
 
@@ -281,6 +327,8 @@ void mainLoader(int, char*[], ServiceManager* services)
 		}
 	}
 
+	startupTimer.mark("Database");
+
 	// load vocations
 	console::print(CONSOLEMESSAGE_TYPE_STARTUP, "Loading vocations ... ", false);
 	if (!g_vocations.loadFromXml()) {
@@ -307,17 +355,26 @@ void mainLoader(int, char*[], ServiceManager* services)
 		return;
 	}
 
-	// load item data
+	startupTimer.mark("Vocations, outfits, mounts, familiars");
+
+	// load item data, items.xml is parsed on a worker thread while items.otb is read
 	console::print(CONSOLEMESSAGE_TYPE_STARTUP, "Loading items ... ", false);
+	auto itemsXml = std::async(std::launch::async, []() {
+		return std::move(loadXmlDocuments({"data/items/items.xml"}).front());
+	});
+
 	if (!Item::items.loadFromOtb("data/items/items.otb")) {
 		startupErrorMessage("Unable to load items.otb!");
 		return;
 	}
 
-	if (!Item::items.loadFromXml()) {
+	//a failed parse is retried by loadFromXml, which then reports the error
+	XmlDocumentResult itemsXmlResult = itemsXml.get();
+	if (!Item::items.loadFromXml(itemsXmlResult.result ? itemsXmlResult.document : nullptr)) {
 		startupErrorMessage("Unable to load items.xml!");
 		return;
 	}
+	startupTimer.mark("Items");
 
 	// load lua scripts
 	console::print(CONSOLEMESSAGE_TYPE_STARTUP, "Loading script systems ... ", false);
@@ -332,11 +389,13 @@ void mainLoader(int, char*[], ServiceManager* services)
 		startupErrorMessage("Failed to load script systems");
 		return;
 	}
+	startupTimer.mark("Script systems");
 
 	if (!g_scripts->loadScripts("scripts", false, false)) {
 		startupErrorMessage("Failed to load lua scripts");
 		return;
 	}
+	startupTimer.mark("Scripts");
 
 	// load monsters
 	//console::print(CONSOLEMESSAGE_TYPE_STARTUP, "Loading monsters ... ");
@@ -349,6 +408,7 @@ void mainLoader(int, char*[], ServiceManager* services)
 		startupErrorMessage("Failed to load lua monsters");
 		return;
 	}
+	startupTimer.mark("Monsters");
 
 	// load world type
 	console::print(CONSOLEMESSAGE_TYPE_STARTUP, "Configuring world type ... ", false);
@@ -379,6 +439,14 @@ void mainLoader(int, char*[], ServiceManager* services)
 		startupErrorMessage("Failed to load map");
 		return;
 	}
+	startupTimer.mark("Map, spawns and houses");
+
+	// the walk checks answer from tile flags instead of the item lists, make sure they agree
+	size_t checkedTiles;
+	const size_t walkFlagMismatches = g_game.map.verifyWalkFlags(checkedTiles);
+	if (walkFlagMismatches != 0) {
+		console::reportWarning("Map::verifyWalkFlags", fmt::format("{:d} of {:d} tiles have walk flags that do not match their items.", walkFlagMismatches, checkedTiles));
+	}
 
 	console::printWorldInfo("Houses", std::to_string(g_game.map.houses.size()));
 
@@ -409,6 +477,12 @@ void mainLoader(int, char*[], ServiceManager* services)
 	services->add<ProtocolOld>(loginPort);
 
 	console::printLoginPorts(loginPort, gamePort, statusPort);
+
+	uint16_t metricsPort = static_cast<uint16_t>(g_config.getNumber(ConfigManager::METRICS_PORT));
+	if (metricsPort != 0 && g_metricsServer.listen(metricsPort)) {
+		g_metricsServer.start();
+		console::printWorldInfo("Metrics port", std::to_string(metricsPort));
+	}
 	//console::print(CONSOLEMESSAGE_TYPE_STARTUP, "Initializing gamestate ...");
 
 	RentPeriod_t rentPeriod;
@@ -437,8 +511,16 @@ void mainLoader(int, char*[], ServiceManager* services)
 	}
 #endif
 
+	startupTimer.mark("Services, market and house rent");
+	startupTimer.print();
+
 	g_game.start(services);
 	g_game.setGameState(GAME_STATE_NORMAL);
+
+	if (PacketReplay::getInstance().isLoaded()) {
+		PacketReplay::getInstance().start();
+	}
+
 	g_loaderSignal.notify_all();
 }
 
@@ -452,7 +534,10 @@ bool argumentsHandler(const StringVector& args)
 			"\t--ip=$1\t\t\tIP address of the server.\n"
 			"\t\t\t\tShould be equal to the global IP.\n"
 			"\t--login-port=$1\tPort for login server to listen on.\n"
-			"\t--game-port=$1\tPort for game server to listen on.\n";
+			"\t--game-port=$1\tPort for game server to listen on.\n"
+			"\t--record=$1\t\tRecord game client packets to a file.\n"
+			"\t--replay=$1\t\tPlay a packet recording back after startup.\n"
+			"\t--replay-seed=$1\tRandom seed used while replaying.\n";
 			return false;
 		} else if (arg == "--version") {
 			printServerVersion();
@@ -469,6 +554,16 @@ bool argumentsHandler(const StringVector& args)
 			g_config.setNumber(ConfigManager::LOGIN_PORT, std::stoi(tmp[1]));
 		else if (tmp[0] == "--game-port")
 			g_config.setNumber(ConfigManager::GAME_PORT, std::stoi(tmp[1]));
+		else if (tmp[0] == "--record") {
+			if (!PacketRecorder::getInstance().open(tmp[1])) {
+				return false;
+			}
+		} else if (tmp[0] == "--replay") {
+			if (!PacketReplay::getInstance().load(tmp[1])) {
+				return false;
+			}
+		} else if (tmp[0] == "--replay-seed")
+			PacketReplay::getInstance().setSeed(std::stoul(tmp[1]));
 	}
 
 	return true;
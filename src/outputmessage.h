@@ -28,16 +28,29 @@ class OutputMessage : public NetworkMessage
 
 		void writeMessageLength() { add_header(static_cast<uint16_t>((info.length - 4) / 8)); }
 
-		void addCryptoHeader(checksumMode_t mode, uint32_t& sequence) {
+		void addCryptoHeader(checksumMode_t mode, uint32_t& sequence, bool compressed = false) {
 			if (mode == CHECKSUM_ADLER) {
 				add_header(adlerChecksum(buffer + outputBufferStart, info.length));
 			} else if (mode == CHECKSUM_SEQUENCE) {
-				add_header(sequence++);
+				add_header(compressed ? (sequence++ | COMPRESSED_FLAG) : sequence++);
 			}
 
 			writeMessageLength();
 		}
 
+		// adler mode with a checksum computed while encrypting
+		void addChecksumHeader(uint32_t checksum) {
+			add_header(checksum);
+			writeMessageLength();
+		}
+
+		// replaces the whole body, used once it has been compressed
+		void setBody(const uint8_t* data, size_t length) {
+			memcpy(buffer + outputBufferStart, data, length);
+			info.length = length;
+			info.position = outputBufferStart + length;
+		}
+
 		void append(const NetworkMessage& msg) {
 			auto msgLen = msg.getLength();
 			memcpy(buffer + info.position, msg.getBuffer() + 8, msgLen);
@@ -53,6 +66,8 @@ class OutputMessage : public NetworkMessage
 		}
 
 	private:
+		static constexpr uint32_t COMPRESSED_FLAG = 1u << 31;
+
 		template <typename T>
 		void add_header(T add) {
 			assert(outputBufferStart >= sizeof(T));
@@ -0,0 +1,274 @@
+// Copyright 2022 The Forgotten Server Authors. All rights reserved.
+// Use of this source code is governed by the GPL-2.0 License that can be found in the LICENSE file.
+
+#include "otpch.h"
+
+#include "packetrecord.h"
+
+#include "game.h"
+#include "metrics.h"
+#include "protocolgame.h"
+#include "rng.h"
+#include "tasks.h"
+
+#include <future>
+
+extern Game g_game;
+
+namespace {
+
+constexpr char RECORD_MAGIC[4] = {'T', 'F', 'S', 'R'};
+constexpr uint16_t RECORD_FORMAT_VERSION = 1;
+
+// time left for the game to handle the last packets before the report is printed
+constexpr auto REPLAY_DRAIN_TIME = std::chrono::seconds(5);
+
+template <typename T>
+bool read(std::istream& in, T& value)
+{
+	return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+std::string formatPercentiles(const metrics::Histogram::Buckets& buckets)
+{
+	return fmt::format("p50 {:.3f} ms, p90 {:.3f} ms, p99 {:.3f} ms, max {:.3f} ms",
+		metrics::Histogram::getPercentile(buckets, 0.5) / 1000.,
+		metrics::Histogram::getPercentile(buckets, 0.9) / 1000.,
+		metrics::Histogram::getPercentile(buckets, 0.99) / 1000.,
+		metrics::Histogram::getPercentile(buckets, 1.0) / 1000.);
+}
+
+metrics::Histogram::Buckets subtract(const metrics::Histogram::Buckets& after, const metrics::Histogram::Buckets& before)
+{
+	metrics::Histogram::Buckets result;
+	for (uint32_t bucket = 0; bucket < metrics::Histogram::BUCKET_COUNT; ++bucket) {
+		result[bucket] = after[bucket] - before[bucket];
+	}
+	return result;
+}
+
+}
+
+bool PacketRecorder::open(const std::string& fileName)
+{
+	std::lock_guard<std::mutex> lockClass(recordLock);
+	file.open(fileName, std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+	if (!file.is_open()) {
+		console::reportError("PacketRecorder::open", fmt::format("Can't open {:s} for writing.", fileName));
+		return false;
+	}
+
+	file.write(RECORD_MAGIC, sizeof(RECORD_MAGIC));
+	write(RECORD_FORMAT_VERSION);
+
+	start = std::chrono::steady_clock::now();
+	recording.store(true, std::memory_order_relaxed);
+	return true;
+}
+
+void PacketRecorder::close()
+{
+	std::lock_guard<std::mutex> lockClass(recordLock);
+	if (recording.exchange(false, std::memory_order_relaxed)) {
+		file.close();
+	}
+}
+
+void PacketRecorder::writeRecordHeader(PacketRecordType_t type, uint32_t session)
+{
+	write(type);
+	write(session);
+	write(static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count()));
+}
+
+uint32_t PacketRecorder::recordLogin(const std::string& name, uint32_t accountId, uint16_t operatingSystem, uint16_t version)
+{
+	std::lock_guard<std::mutex> lockClass(recordLock);
+	if (!isRecording()) {
+		return 0;
+	}
+
+	uint32_t session = ++lastSession;
+	writeRecordHeader(PACKET_RECORD_LOGIN, session);
+	write(version);
+	write(operatingSystem);
+	write(accountId);
+	write(static_cast<uint16_t>(name.size()));
+	file.write(name.data(), name.size());
+	return session;
+}
+
+void PacketRecorder::recordPacket(uint32_t session, const NetworkMessage& msg)
+{
+	//the message is stored as the protocol sees it, the readable area ends 8 bytes after its length
+	const size_t position = msg.getBufferPosition();
+	const size_t end = std::min<size_t>(msg.getLength() + 8, NETWORKMESSAGE_MAXSIZE);
+	const uint16_t size = end > position ? static_cast<uint16_t>(end - position) : 0;
+
+	std::lock_guard<std::mutex> lockClass(recordLock);
+	if (!isRecording()) {
+		return;
+	}
+
+	writeRecordHeader(PACKET_RECORD_PACKET, session);
+	write(static_cast<uint16_t>(position));
+	write(msg.getLength());
+	write(size);
+	file.write(reinterpret_cast<const char*>(msg.getBuffer() + position), size);
+}
+
+void PacketRecorder::recordClose(uint32_t session)
+{
+	std::lock_guard<std::mutex> lockClass(recordLock);
+	if (!isRecording()) {
+		return;
+	}
+
+	writeRecordHeader(PACKET_RECORD_CLOSE, session);
+}
+
+bool PacketReplay::load(const std::string& fileName)
+{
+	std::ifstream in(fileName, std::ifstream::in | std::ifstream::binary);
+	if (!in.is_open()) {
+		console::reportError("PacketReplay::load", fmt::format("Can't open {:s}.", fileName));
+		return false;
+	}
+
+	char magic[sizeof(RECORD_MAGIC)];
+	uint16_t formatVersion;
+	if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), RECORD_MAGIC) || !read(in, formatVersion) || formatVersion != RECORD_FORMAT_VERSION) {
+		console::reportError("PacketReplay::load", fmt::format("{:s} is not a packet recording.", fileName));
+		return false;
+	}
+
+	records.clear();
+	Record record;
+	while (read(in, record.type) && read(in, record.session) && read(in, record.time)) {
+		bool valid = true;
+		switch (record.type) {
+			case PACKET_RECORD_LOGIN: {
+				uint16_t nameLength;
+				valid = read(in, record.version) && read(in, record.operatingSystem) && read(in, record.accountId) && read(in, nameLength);
+				if (valid) {
+					record.name.resize(nameLength);
+					valid = static_cast<bool>(in.read(&record.name[0], nameLength));
+				}
+				break;
+			}
+
+			case PACKET_RECORD_PACKET: {
+				uint16_t size;
+				valid = read(in, record.position) && read(in, record.length) && read(in, size) && record.position >= NetworkMessage::INITIAL_BUFFER_POSITION && record.position + size <= NETWORKMESSAGE_MAXSIZE;
+				if (valid) {
+					record.data.resize(size);
+					valid = static_cast<bool>(in.read(reinterpret_cast<char*>(record.data.data()), size));
+				}
+				break;
+			}
+
+			case PACKET_RECORD_CLOSE:
+				break;
+
+			default:
+				valid = false;
+				break;
+		}
+
+		if (!valid) {
+			//a recording cut short by a crash still replays up to the last complete record
+			console::reportWarning("PacketReplay::load", fmt::format("{:s} ends with an incomplete record, replaying {:d} records.", fileName, records.size()));
+			break;
+		}
+
+		records.push_back(std::move(record));
+		record = Record();
+	}
+	return !records.empty();
+}
+
+void PacketReplay::threadMain()
+{
+	metrics::Registry& registry = metrics::Registry::getInstance();
+	metrics::Histogram& tickDuration = registry.histogram("tfs_game_tick_duration_seconds", "Time spent in one creature check round");
+	metrics::Histogram& queueLatency = registry.histogram("tfs_dispatcher_queue_latency_seconds", "Time tasks wait in the dispatcher queue", "dispatcher=\"0\"");
+	metrics::Counter& sentBytes = registry.counter("tfs_network_sent_bytes_total", "Bytes written to client connections");
+
+	std::promise<void> seeded;
+	g_dispatcher.addTask(createTask(([this, &seeded]() {
+		rng::seed(seed);
+		seeded.set_value();
+	})));
+	seeded.get_future().wait();
+
+	const auto tickBefore = tickDuration.getBuckets();
+	const auto latencyBefore = queueLatency.getBuckets();
+	const uint64_t sentBefore = sentBytes.get();
+
+	console::print(CONSOLEMESSAGE_TYPE_INFO, fmt::format("Replaying {:d} records with seed {:d} ...", records.size(), seed));
+
+	std::unordered_map<uint32_t, ProtocolGame_ptr> sessions;
+	size_t packets = 0;
+	const auto start = std::chrono::steady_clock::now();
+	for (const Record& record : records) {
+		std::this_thread::sleep_until(start + std::chrono::milliseconds(record.time));
+		if (getState() != THREAD_STATE_RUNNING) {
+			break;
+		}
+
+		switch (record.type) {
+			case PACKET_RECORD_LOGIN: {
+				auto protocol = std::make_shared<ProtocolGame>(nullptr);
+				protocol->setHeadless();
+				protocol->version = record.version;
+				sessions[record.session] = protocol;
+
+				OperatingSystem_t operatingSystem = static_cast<OperatingSystem_t>(record.operatingSystem);
+				g_dispatcher.addTask(createTask(([protocol, name = record.name, accountId = record.accountId, operatingSystem]() {
+					protocol->login(name, accountId, operatingSystem);
+				})));
+				break;
+			}
+
+			case PACKET_RECORD_PACKET: {
+				auto it = sessions.find(record.session);
+				if (it == sessions.end()) {
+					break;
+				}
+
+				//same entry point as a decrypted packet coming from the connection
+				NetworkMessage msg;
+				std::copy(record.data.begin(), record.data.end(), msg.getBuffer() + record.position);
+				msg.setLength(record.length);
+				msg.setBufferPosition(record.position - NetworkMessage::INITIAL_BUFFER_POSITION);
+				static_cast<Protocol&>(*it->second).parsePacket(msg);
+				++packets;
+				break;
+			}
+
+			case PACKET_RECORD_CLOSE: {
+				auto it = sessions.find(record.session);
+				if (it == sessions.end()) {
+					break;
+				}
+
+				g_dispatcher.addTask(createTask([protocol = it->second]() { protocol->release(); }));
+				sessions.erase(it);
+				break;
+			}
+		}
+	}
+
+	const auto replayTime = std::chrono::steady_clock::now() - start;
+	std::this_thread::sleep_for(REPLAY_DRAIN_TIME);
+
+	console::print(CONSOLEMESSAGE_TYPE_INFO, fmt::format("Replay finished: {:d} packets in {:.1f} s.", packets, std::chrono::duration<double>(replayTime).count()));
+	console::print(CONSOLEMESSAGE_TYPE_INFO, "Tick time: " + formatPercentiles(subtract(tickDuration.getBuckets(), tickBefore)));
+	console::print(CONSOLEMESSAGE_TYPE_INFO, "Dispatcher queue latency: " + formatPercentiles(subtract(queueLatency.getBuckets(), latencyBefore)));
+	console::print(CONSOLEMESSAGE_TYPE_INFO, fmt::format("Bytes sent: {:d}", sentBytes.get() - sentBefore));
+
+	for (const auto& it : sessions) {
+		g_dispatcher.addTask(createTask([protocol = it.second]() { protocol->release(); }));
+	}
+	g_dispatcher.addTask(createTask([]() { g_game.setGameState(GAME_STATE_SHUTDOWN); }));
+}
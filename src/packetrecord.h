@@ -0,0 +1,107 @@
+// Copyright 2022 The Forgotten Server Authors. All rights reserved.
+// Use of this source code is governed by the GPL-2.0 License that can be found in the LICENSE file.
+
+#ifndef FS_PACKETRECORD_H
+#define FS_PACKETRECORD_H
+
+#include "thread_holder_base.h"
+
+#include <fstream>
+
+class NetworkMessage;
+
+/*
+ * recordings hold the decrypted packets game clients sent, one session per
+ * login, so a real session can be fed back into the game without sockets
+ *
+ * file: "TFSR", u16 format version, then records of
+ * u8 type, u32 session, u32 milliseconds since the recording started and
+ *   login:  u16 client version, u16 operating system, u32 account id, u16 + name
+ *   packet: u16 read position, u16 message length, u16 + message bytes
+ *   close:  nothing
+ */
+enum PacketRecordType_t : uint8_t {
+	PACKET_RECORD_LOGIN = 1,
+	PACKET_RECORD_PACKET = 2,
+	PACKET_RECORD_CLOSE = 3,
+};
+
+class PacketRecorder
+{
+	public:
+		static PacketRecorder& getInstance() {
+			static PacketRecorder instance;
+			return instance;
+		}
+
+		bool open(const std::string& fileName);
+		void close();
+
+		bool isRecording() const {
+			return recording.load(std::memory_order_relaxed);
+		}
+
+		// returns the session the following records belong to, 0 when not recording
+		uint32_t recordLogin(const std::string& name, uint32_t accountId, uint16_t operatingSystem, uint16_t version);
+		void recordPacket(uint32_t session, const NetworkMessage& msg);
+		void recordClose(uint32_t session);
+
+	private:
+		PacketRecorder() = default;
+
+		template <typename T>
+		void write(T value) {
+			file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+		}
+		void writeRecordHeader(PacketRecordType_t type, uint32_t session);
+
+		std::ofstream file;
+		std::mutex recordLock;
+		std::chrono::steady_clock::time_point start;
+		std::atomic<bool> recording {false};
+		uint32_t lastSession = 0;
+};
+
+// plays a recording back against the local game, in real time and with a fixed random seed
+class PacketReplay : public ThreadHolder<PacketReplay>
+{
+	public:
+		static PacketReplay& getInstance() {
+			static PacketReplay instance;
+			return instance;
+		}
+
+		bool load(const std::string& fileName);
+		bool isLoaded() const {
+			return !records.empty();
+		}
+
+		void setSeed(uint32_t seed) {
+			this->seed = seed;
+		}
+
+		void threadMain();
+
+	private:
+		PacketReplay() = default;
+
+		struct Record {
+			PacketRecordType_t type;
+			uint32_t session;
+			uint32_t time;
+			// login
+			std::string name;
+			uint32_t accountId = 0;
+			uint16_t operatingSystem = 0;
+			uint16_t version = 0;
+			// packet
+			uint16_t position = 0;
+			uint16_t length = 0;
+			std::vector<uint8_t> data;
+		};
+
+		std::vector<Record> records;
+		uint32_t seed = 0x5EED;
+};
+
+#endif
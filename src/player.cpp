@@ -752,6 +752,11 @@ void Player::addStorageValue(const uint32_t key, const int32_t value, const bool
 				value >> 16,
 				value & 0xFF
 			);
+
+			//kept so genReservedStorageRange can tell which rows changed
+			if (isLogin) {
+				storageMap[key] = value;
+			}
 			return;
 		} else if (IS_IN_KEYRANGE(key, MOUNTS_RANGE) || IS_IN_KEYRANGE(key, FAMILIARS_RANGE) || IS_IN_KEYRANGE(key, AUTOLOOT_RANGE)) {
 			// do nothing
@@ -768,6 +773,10 @@ void Player::addStorageValue(const uint32_t key, const int32_t value, const bool
 		storageMap[key] = value;
 
 		if (!isLogin) {
+			if (oldValue != value) {
+				dirtyStorageKeys.insert(key);
+			}
+
 			auto currentFrameTime = g_dispatcher.getDispatcherCycle();
 			if (lastQuestlogUpdate != currentFrameTime && g_game.quests.isQuestStorage(key, value, oldValue)) {
 				lastQuestlogUpdate = currentFrameTime;
@@ -782,8 +791,8 @@ void Player::addStorageValue(const uint32_t key, const int32_t value, const bool
 				}
 			}
 		}
-	} else {
-		storageMap.erase(key);
+	} else if (storageMap.erase(key) != 0) {
+		dirtyStorageKeys.insert(key);
 	}
 }
 
@@ -1774,16 +1783,20 @@ void Player::onThink(uint32_t interval)
 
 	int64_t timeNow = OTSYS_TIME();
 
-	// refresh imbuements
-	if (timeNow % 60 == 0) {
+	// an imbuement ran out or its remaining minutes changed
+	if (nextImbuementUpdate != 0 && timeNow >= nextImbuementUpdate) {
 		consumeImbuements(true, getZone() != ZONE_PROTECTION && hasCondition(CONDITION_INFIGHT));
 		sendImbuementsPanel();
 	}
 
-	// fix desynced equipment timers after alt tabbing
-	if (timeNow % 10 == 0) {
-		for (int i = CONST_SLOT_FIRST; i <= CONST_SLOT_LAST; ++i) {
-			sendInventoryItem(static_cast<slots_t>(i), getInventoryItem(static_cast<slots_t>(i)));
+	// fix desynced equipment timers after alt tabbing, only items showing a running duration need it
+	if (timeNow >= nextEquipmentSync) {
+		nextEquipmentSync = timeNow + 10000;
+		for (int32_t slot = CONST_SLOT_FIRST; slot <= CONST_SLOT_LAST; ++slot) {
+			Item* item = inventory[slot];
+			if (item && Item::items[item->getID()].showClientDuration && g_game.isDecaying(item)) {
+				sendInventoryItem(static_cast<slots_t>(slot), item);
+			}
 		}
 	}
 
@@ -2403,6 +2416,15 @@ uint32_t Player::getIP() const
 	return 0;
 }
 
+uint64_t Player::getSentBytes() const
+{
+	if (client) {
+		return client->getSentBytes();
+	}
+
+	return 0;
+}
+
 void Player::death(Creature* lastHitCreature)
 {
 	loginPosition = town->getTemplePosition();
@@ -4548,7 +4570,31 @@ void Player::genReservedStorageRange()
 	//generate outfits range
 	uint32_t base_key = PSTRG_OUTFITS_RANGE_START;
 	for (const OutfitEntry& entry : outfits) {
-		storageMap[++base_key] = (entry.lookType << 16) | entry.addons;
+		const int32_t value = (entry.lookType << 16) | entry.addons;
+		auto it = storageMap.find(++base_key);
+		if (it == storageMap.end()) {
+			storageMap.emplace(base_key, value);
+			dirtyStorageKeys.insert(base_key);
+		} else if (it->second != value) {
+			it->second = value;
+			dirtyStorageKeys.insert(base_key);
+		}
+	}
+
+	//outfits removed since the last save
+	while (++base_key <= static_cast<uint32_t>(PSTRG_OUTFITS_RANGE_START + PSTRG_OUTFITS_RANGE_SIZE) && storageMap.erase(base_key) != 0) {
+		dirtyStorageKeys.insert(base_key);
+	}
+}
+
+void Player::onStoragesSaved(const std::vector<std::pair<uint32_t, int32_t>>& storages)
+{
+	for (const auto& it : storages) {
+		int32_t value;
+		getStorageValue(it.first, value);
+		if (value == it.second) {
+			dirtyStorageKeys.erase(it.first);
+		}
 	}
 }
 
@@ -5657,6 +5703,43 @@ void Player::updateStoreCoins()
 	}
 }
 
+void Player::scheduleImbuementUpdate()
+{
+	const bool inFight = getZone() != ZONE_PROTECTION && hasCondition(CONDITION_INFIGHT);
+
+	nextImbuementUpdate = 0;
+	for (int32_t slot = CONST_SLOT_FIRST; slot <= CONST_SLOT_LAST; ++slot) {
+		Item* item = inventory[slot];
+		if (!item) {
+			continue;
+		}
+
+		for (const auto& it : item->getImbuements()) {
+			const Imbuement& imbuement = it.second;
+			if (imbuement.getDuration() <= 0) {
+				continue;
+			}
+
+			// same rule as Item::refreshImbuements, paused imbuements do not change
+			ImbuementType* imbuementType = g_imbuements.getImbuementType(imbuement.getImbuId());
+			if (!imbuementType || !(inFight || imbuementType->isOutOfCombat())) {
+				continue;
+			}
+
+			// expiry, or the next minute shown on the panel
+			int64_t seconds = imbuement.getDuration();
+			if (imbuPanelOn && seconds > 60) {
+				seconds = seconds % 60 == 0 ? 60 : seconds % 60;
+			}
+
+			int64_t updateTime = imbuement.getLastUpdateTime() + seconds * 1000;
+			if (nextImbuementUpdate == 0 || updateTime < nextImbuementUpdate) {
+				nextImbuementUpdate = updateTime;
+			}
+		}
+	}
+}
+
 void Player::toggleImbuement(uint8_t imbuId, bool isEquip)
 {
 	if (imbuId == 0) {
@@ -5750,4 +5833,5 @@ void Player::toggleImbuements(Item* item, bool isEquip, bool silent)
 void Player::toggleImbuPanel(bool enabled)
 {
 	imbuPanelOn = enabled;
+	scheduleImbuementUpdate();
 }
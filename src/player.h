@@ -363,6 +363,7 @@ class Player final : public Creature, public Cylinder
 			}
 		}
 		uint32_t getIP() const;
+		uint64_t getSentBytes() const;
 
 		uint8_t getNextContainerIndex();
 		void addContainer(uint8_t cid, Container* container);
@@ -381,6 +382,8 @@ class Player final : public Creature, public Cylinder
 		void addStorageValue(const uint32_t key, const int32_t value, const bool isLogin = false);
 		bool getStorageValue(const uint32_t key, int32_t& value) const;
 		void genReservedStorageRange();
+		// forgets the changes a save wrote, unless the key was changed again meanwhile
+		void onStoragesSaved(const std::vector<std::pair<uint32_t, int32_t>>& storages);
 
 		void setGroup(Group* newGroup) {
 			group = newGroup;
@@ -1025,6 +1028,9 @@ class Player final : public Creature, public Cylinder
 		}
 		void sendModalWindow(const ModalWindow& modalWindow);
 		void sendImbuementsPanel() {
+			// every imbuement change ends with a panel update, so the next timed one is planned here
+			scheduleImbuementUpdate();
+
 			if (client && imbuPanelOn) {
 				std::map<slots_t, Item*> itemsToSend;
 				for (uint8_t slot = CONST_SLOT_FIRST; slot < CONST_SLOT_LAST; ++slot) {
@@ -1427,6 +1433,7 @@ class Player final : public Creature, public Cylinder
 		void toggleImbuement(uint8_t imbuId, bool isEquip);
 		void toggleImbuements(Item* item, bool isEquip, bool silent = false);
 		void toggleImbuPanel(bool enabled);
+		void scheduleImbuementUpdate();
 
 		void linkDepot() {
 			inDepot = true;
@@ -1487,7 +1494,9 @@ class Player final : public Creature, public Cylinder
 
 		std::map<uint8_t, OpenContainer> openContainers;
 		std::map<uint32_t, DepotChest*> depotChests;
-		std::map<uint32_t, int32_t> storageMap;
+		std::unordered_map<uint32_t, int32_t> storageMap;
+		// keys changed since they were last written, a save only touches these rows
+		std::unordered_set<uint32_t> dirtyStorageKeys;
 		std::map<LootTypes_t, int32_t> lootContainers;
 
 		std::vector<OutfitEntry> outfits;
@@ -1529,6 +1538,8 @@ class Player final : public Creature, public Cylinder
 		int64_t lastToggleMount = 0;
 		int64_t lastPing;
 		int64_t lastPong;
+		int64_t nextImbuementUpdate = 0; // 0 if no equipped imbuement is running
+		int64_t nextEquipmentSync = 0;
 
 		// cooldowns
 		int64_t nextAction = 0;
@@ -0,0 +1,261 @@
+// Copyright 2022 The Forgotten Server Authors. All rights reserved.
+// Use of this source code is governed by the GPL-2.0 License that can be found in the LICENSE file.
+
+#include "otpch.h"
+
+#include "playernamecache.h"
+
+#include "database.h"
+#include "metrics.h"
+#include "tasks.h"
+#include "tools.h"
+
+namespace {
+
+metrics::Counter& lookupCounter(const char* result)
+{
+	return metrics::Registry::getInstance().counter("tfs_player_name_cache_lookups_total", "Player name and guid lookups by cache result", fmt::format("result=\"{:s}\"", result));
+}
+
+metrics::Counter& hits = lookupCounter("hit");
+metrics::Counter& missingHits = lookupCounter("missing");
+metrics::Counter& misses = lookupCounter("miss");
+metrics::Counter& dispatcherQueriesAvoided = metrics::Registry::getInstance().counter("tfs_player_name_cache_dispatcher_queries_avoided_total", "Database queries the dispatcher did not run because the player name cache answered");
+metrics::Gauge& cacheEntries = metrics::Registry::getInstance().gauge("tfs_player_name_cache_entries", "Players and missing names held by the player name cache");
+
+PlayerNameCache::Lookup record(PlayerNameCache::Lookup result)
+{
+	switch (result) {
+		case PlayerNameCache::LOOKUP_FOUND:
+			hits.increment();
+			break;
+		case PlayerNameCache::LOOKUP_MISSING:
+			missingHits.increment();
+			break;
+		default:
+			misses.increment();
+			return result;
+	}
+
+	if (g_dispatcher.isCurrentThread()) {
+		dispatcherQueriesAvoided.increment();
+	}
+	return result;
+}
+
+}
+
+PlayerNameCache::PlayerNameCache() = default;
+
+void PlayerNameCache::setCapacity(size_t newCapacity)
+{
+	std::lock_guard<std::mutex> lockClass(cacheLock);
+	capacity = newCapacity;
+	while (nodes.size() > capacity) {
+		erase(std::prev(nodes.end()));
+	}
+	cacheEntries.set(nodes.size());
+}
+
+PlayerNameCache::Lookup PlayerNameCache::getByName(const std::string& name, PlayerNameEntry& entry)
+{
+	std::lock_guard<std::mutex> lockClass(cacheLock);
+	auto it = byName.find(asLowerCaseString(name));
+	if (it == byName.end()) {
+		return record(LOOKUP_UNKNOWN);
+	}
+	return record(find(it->second, entry));
+}
+
+PlayerNameCache::Lookup PlayerNameCache::getByGuid(uint32_t guid, PlayerNameEntry& entry)
+{
+	std::lock_guard<std::mutex> lockClass(cacheLock);
+	auto it = byGuid.find(guid);
+	if (it == byGuid.end()) {
+		return record(LOOKUP_UNKNOWN);
+	}
+	return record(find(it->second, entry));
+}
+
+void PlayerNameCache::insert(const PlayerNameEntry& entry)
+{
+	std::lock_guard<std::mutex> lockClass(cacheLock);
+	if (capacity == 0) {
+		return;
+	}
+
+	std::string key = asLowerCaseString(entry.name);
+
+	//drop the old name of this player and whatever else was known under the new one
+	auto guidIt = byGuid.find(entry.guid);
+	if (guidIt != byGuid.end()) {
+		erase(guidIt->second);
+	}
+
+	auto nameIt = byName.find(key);
+	if (nameIt != byName.end()) {
+		erase(nameIt->second);
+	}
+
+	push({entry, std::move(key), Clock::now() + FOUND_TTL, false});
+}
+
+void PlayerNameCache::insertMissing(const std::string& name)
+{
+	std::lock_guard<std::mutex> lockClass(cacheLock);
+	if (capacity == 0) {
+		return;
+	}
+
+	std::string key = asLowerCaseString(name);
+	auto it = byName.find(key);
+	if (it != byName.end()) {
+		erase(it->second);
+	}
+
+	push({{}, std::move(key), Clock::now() + MISSING_TTL, true});
+}
+
+void PlayerNameCache::insertMissing(uint32_t guid)
+{
+	std::lock_guard<std::mutex> lockClass(cacheLock);
+	if (capacity == 0) {
+		return;
+	}
+
+	auto it = byGuid.find(guid);
+	if (it != byGuid.end()) {
+		erase(it->second);
+	}
+
+	PlayerNameEntry entry;
+	entry.guid = guid;
+	push({std::move(entry), {}, Clock::now() + MISSING_TTL, true});
+}
+
+void PlayerNameCache::rename(uint32_t guid, const std::string& newName)
+{
+	PlayerNameEntry entry;
+	{
+		std::lock_guard<std::mutex> lockClass(cacheLock);
+		auto guidIt = byGuid.find(guid);
+		if (guidIt == byGuid.end() || guidIt->second->missing) {
+			//nothing cached for the player, only forget that the new name did not exist
+			auto nameIt = byName.find(asLowerCaseString(newName));
+			if (nameIt != byName.end()) {
+				erase(nameIt->second);
+			}
+			cacheEntries.set(nodes.size());
+			return;
+		}
+		entry = guidIt->second->entry;
+	}
+
+	entry.name = newName;
+	insert(entry);
+}
+
+void PlayerNameCache::remove(uint32_t guid)
+{
+	std::lock_guard<std::mutex> lockClass(cacheLock);
+	auto it = byGuid.find(guid);
+	if (it != byGuid.end()) {
+		erase(it->second);
+		cacheEntries.set(nodes.size());
+	}
+}
+
+void PlayerNameCache::remove(const std::string& name)
+{
+	std::lock_guard<std::mutex> lockClass(cacheLock);
+	auto it = byName.find(asLowerCaseString(name));
+	if (it != byName.end()) {
+		erase(it->second);
+		cacheEntries.set(nodes.size());
+	}
+}
+
+size_t PlayerNameCache::preload(Database& db)
+{
+	size_t limit;
+	{
+		std::lock_guard<std::mutex> lockClass(cacheLock);
+		limit = capacity;
+	}
+
+	if (limit == 0) {
+		return 0;
+	}
+
+	//players scheduled for deletion are removed by the startup script, skip them
+	DBResult_ptr result = db.storeQuery(fmt::format("SELECT `id`, `name`, `account_id`, `group_id` FROM `players` WHERE `deletion` = 0 OR `deletion` >= {:d} ORDER BY `lastlogin` DESC LIMIT {:d}", time(nullptr), limit));
+	if (!result) {
+		return 0;
+	}
+
+	const size_t idColumn = result->getColumnIndex("id");
+	const size_t nameColumn = result->getColumnIndex("name");
+	const size_t accountIdColumn = result->getColumnIndex("account_id");
+	const size_t groupIdColumn = result->getColumnIndex("group_id");
+
+	std::vector<PlayerNameEntry> entries;
+	do {
+		PlayerNameEntry& entry = entries.emplace_back();
+		entry.guid = result->getNumber<uint32_t>(idColumn);
+		entry.name = result->getString(nameColumn);
+		entry.accountId = result->getNumber<uint32_t>(accountIdColumn);
+		entry.groupId = result->getNumber<uint16_t>(groupIdColumn);
+	} while (result->next());
+
+	//least recently active first, so they are the first to be evicted
+	for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+		insert(*it);
+	}
+	return entries.size();
+}
+
+PlayerNameCache::Lookup PlayerNameCache::find(NodeList::iterator it, PlayerNameEntry& entry)
+{
+	if (it->expiresAt <= Clock::now()) {
+		erase(it);
+		cacheEntries.set(nodes.size());
+		return LOOKUP_UNKNOWN;
+	}
+
+	nodes.splice(nodes.begin(), nodes, it);
+	if (it->missing) {
+		return LOOKUP_MISSING;
+	}
+
+	entry = it->entry;
+	return LOOKUP_FOUND;
+}
+
+void PlayerNameCache::push(Node&& node)
+{
+	nodes.push_front(std::move(node));
+
+	auto it = nodes.begin();
+	if (!it->key.empty()) {
+		byName[it->key] = it;
+	}
+	if (!it->missing || it->key.empty()) {
+		byGuid[it->entry.guid] = it;
+	}
+
+	while (nodes.size() > capacity) {
+		erase(std::prev(nodes.end()));
+	}
+	cacheEntries.set(nodes.size());
+}
+
+void PlayerNameCache::erase(NodeList::iterator it)
+{
+	if (!it->key.empty()) {
+		byName.erase(it->key);
+	}
+	if (!it->missing || it->key.empty()) {
+		byGuid.erase(it->entry.guid);
+	}
+	nodes.erase(it);
+}
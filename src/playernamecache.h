@@ -0,0 +1,90 @@
+// Copyright 2022 The Forgotten Server Authors. All rights reserved.
+// Use of this source code is governed by the GPL-2.0 License that can be found in the LICENSE file.
+
+#ifndef FS_PLAYERNAMECACHE_H
+#define FS_PLAYERNAMECACHE_H
+
+class Database;
+
+struct PlayerNameEntry {
+	uint32_t guid = 0;
+	uint32_t accountId = 0;
+	uint16_t groupId = 0;
+	std::string name;
+};
+
+/*
+ * bounded cache of the players table columns looked up by name or guid (vip
+ * lists, house access lists, private messages, guilds and scripts), names are
+ * matched case-insensitively like the database does. Lookups that found no
+ * player are remembered for a short time so repeated misses (typos, whispers
+ * to a missing name) do not reach the database either. Entries expire, and
+ * every full player load refreshes or drops the entry of that player
+ */
+class PlayerNameCache
+{
+	public:
+		// rows can change outside the server (website, database tools, scripts), no entry is trusted forever
+		static constexpr auto FOUND_TTL = std::chrono::minutes(5);
+		static constexpr auto MISSING_TTL = std::chrono::seconds(30);
+
+		enum Lookup {
+			LOOKUP_UNKNOWN,
+			LOOKUP_FOUND,
+			LOOKUP_MISSING,
+		};
+
+		static PlayerNameCache& getInstance() {
+			static PlayerNameCache instance;
+			return instance;
+		}
+
+		// non-copyable
+		PlayerNameCache(const PlayerNameCache&) = delete;
+		PlayerNameCache& operator=(const PlayerNameCache&) = delete;
+
+		// 0 disables the cache
+		void setCapacity(size_t newCapacity);
+
+		Lookup getByName(const std::string& name, PlayerNameEntry& entry);
+		Lookup getByGuid(uint32_t guid, PlayerNameEntry& entry);
+
+		void insert(const PlayerNameEntry& entry);
+		void insertMissing(const std::string& name);
+		void insertMissing(uint32_t guid);
+
+		// the player got a new name (the row is updated on the next save)
+		void rename(uint32_t guid, const std::string& newName);
+		// a lookup found no player row, forget what was cached for it
+		void remove(uint32_t guid);
+		void remove(const std::string& name);
+
+		// fills the cache with the most recently active players, returns the number of entries loaded
+		size_t preload(Database& db);
+
+	private:
+		PlayerNameCache();
+
+		using Clock = std::chrono::steady_clock;
+
+		struct Node {
+			PlayerNameEntry entry;
+			std::string key;
+			Clock::time_point expiresAt;
+			bool missing;
+		};
+
+		using NodeList = std::list<Node>;
+
+		Lookup find(NodeList::iterator it, PlayerNameEntry& entry);
+		void push(Node&& node);
+		void erase(NodeList::iterator it);
+
+		std::mutex cacheLock;
+		NodeList nodes; // most recently used first
+		std::unordered_map<std::string, NodeList::iterator> byName;
+		std::unordered_map<uint32_t, NodeList::iterator> byGuid;
+		size_t capacity = 0;
+};
+
+#endif
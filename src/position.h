@@ -116,6 +116,15 @@ struct Position
 	int_fast16_t getZ() const { return z; }
 };
 
+namespace std {
+template <>
+struct hash<Position> {
+	std::size_t operator()(const Position& p) const noexcept {
+		return static_cast<std::size_t>((static_cast<uint64_t>(p.z) << 32) | (static_cast<uint64_t>(p.y) << 16) | p.x);
+	}
+};
+}
+
 std::ostream& operator<<(std::ostream&, const Position&);
 std::ostream& operator<<(std::ostream&, const Direction&);
 
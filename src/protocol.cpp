@@ -4,14 +4,26 @@
 #include "otpch.h"
 
 #include "protocol.h"
+#include "adler32.h"
+#include "configmanager.h"
+#include "metrics.h"
 #include "outputmessage.h"
 #include "rsa.h"
 #include "xtea.h"
 
+extern ConfigManager g_config;
 extern RSA g_RSA;
 
 namespace {
 
+// smaller packets do not gain enough to be worth the stream state they touch
+constexpr NetworkMessage::MsgSize_t COMPRESSION_MIN_LENGTH = 128;
+
+// a multiple of the xtea block size, small enough to stay in L1 between encrypting and summing
+constexpr size_t FUSED_CHUNK_SIZE = 1024;
+
+metrics::Counter& sentBytesTotal = metrics::Registry::getInstance().counter("tfs_network_sent_bytes_total", "Bytes written to client connections");
+
 void XTEA_encrypt(OutputMessage& msg, const xtea::round_keys& key)
 {
 	// The message must be a multiple of 8
@@ -24,6 +36,26 @@ void XTEA_encrypt(OutputMessage& msg, const xtea::round_keys& key)
 	xtea::encrypt(buffer, msg.getLength(), key);
 }
 
+// pads, encrypts and checksums in one pass: each chunk is summed right after it is encrypted, while it is still in cache
+uint32_t XTEA_encryptWithChecksum(OutputMessage& msg, const xtea::round_keys& key)
+{
+	size_t paddingBytes = msg.getLength() % 8u;
+	if (paddingBytes != 0) {
+		msg.addPaddingBytes(8 - paddingBytes);
+	}
+
+	uint8_t* buffer = msg.getOutputBuffer();
+	size_t length = msg.getLength();
+
+	uint32_t checksum = adler::INITIAL;
+	for (size_t offset = 0; offset < length; offset += FUSED_CHUNK_SIZE) {
+		size_t chunkLength = std::min(FUSED_CHUNK_SIZE, length - offset);
+		xtea::encrypt(buffer + offset, chunkLength, key);
+		checksum = adler::update(checksum, buffer + offset, chunkLength);
+	}
+	return checksum;
+}
+
 bool XTEA_decrypt(NetworkMessage& msg, const xtea::round_keys& key)
 {
 	if (((msg.getLength() - 6) & 7) != 0) {
@@ -39,7 +71,7 @@ bool XTEA_decrypt(NetworkMessage& msg, const xtea::round_keys& key)
 		return false;
 	}
 
-	msg.setLength(messageLength);
+	msg.setLength(innerLength);
 	return true;
 }
 
@@ -48,13 +80,30 @@ bool XTEA_decrypt(NetworkMessage& msg, const xtea::round_keys& key)
 void Protocol::onSendMessage(const OutputMessage_ptr& msg)
 {
 	if (!rawMessages) {
+		bool compressed = deflater && compress(*msg);
 		if (!encryptionEnabled) {
 			msg->writeMessageLength();
-			return;
+		} else {
+			msg->writePaddingLength();
+			if (checksumMode == CHECKSUM_ADLER) {
+				msg->addChecksumHeader(XTEA_encryptWithChecksum(*msg, key));
+			} else {
+				XTEA_encrypt(*msg, key);
+				msg->addCryptoHeader(checksumMode, sequenceNumber, compressed);
+			}
 		}
-		msg->writePaddingLength();
-		XTEA_encrypt(*msg, key);
-		msg->addCryptoHeader(checksumMode, sequenceNumber);
+	}
+	sentBytes.fetch_add(msg->getLength(), std::memory_order_relaxed);
+	sentBytesTotal.increment(msg->getLength());
+}
+
+void Protocol::send(OutputMessage_ptr msg) const
+{
+	if (auto connection = getConnection()) {
+		connection->send(msg);
+	} else if (headless) {
+		//nothing goes out, the message is only accounted for
+		sentBytesTotal.increment(getHeadlessLength(*msg));
 	}
 }
 
@@ -70,6 +119,67 @@ void Protocol::onRecvMessage(NetworkMessage& msg)
 	parsePacket(msg);
 }
 
+void Protocol::enableCompression()
+{
+	if (checksumMode != CHECKSUM_SEQUENCE || !g_config.getBoolean(ConfigManager::PACKET_COMPRESSION)) {
+		return;
+	}
+
+	deflater.reset(new PacketDeflater(g_config.getNumber(ConfigManager::PACKET_COMPRESSION_LEVEL)));
+	if (!deflater->isInitialized()) {
+		deflater.reset();
+		return;
+	}
+
+	if (headless) {
+		inflater.reset(new PacketInflater());
+		if (!inflater->isInitialized()) {
+			deflater.reset();
+			inflater.reset();
+		}
+	}
+}
+
+bool Protocol::compress(OutputMessage& msg)
+{
+	//connection strand, packets reach the stream in the order they are sent
+	NetworkMessage::MsgSize_t length = msg.getLength();
+	if (length < COMPRESSION_MIN_LENGTH || deflater->getBound(length) > NetworkMessage::MAX_BODY_LENGTH) {
+		return false;
+	}
+
+	static thread_local std::array<uint8_t, NETWORKMESSAGE_MAXSIZE> compressed;
+	size_t compressedLength;
+	if (!deflater->compress(msg.getOutputBuffer(), length, compressed.data(), NetworkMessage::MAX_BODY_LENGTH, compressedLength)) {
+		deflater.reset();
+		return false;
+	}
+
+	msg.setBody(compressed.data(), compressedLength);
+	return true;
+}
+
+size_t Protocol::getHeadlessLength(OutputMessage& msg) const
+{
+	//dispatcher thread, the replay client decodes what a connection would have sent
+	NetworkMessage::MsgSize_t length = msg.getLength();
+	if (!deflater || !inflater || length < COMPRESSION_MIN_LENGTH || deflater->getBound(length) > NetworkMessage::MAX_BODY_LENGTH) {
+		return length;
+	}
+
+	static thread_local std::array<uint8_t, NETWORKMESSAGE_MAXSIZE> compressed;
+	size_t compressedLength;
+	if (!deflater->compress(msg.getOutputBuffer(), length, compressed.data(), NetworkMessage::MAX_BODY_LENGTH, compressedLength)) {
+		return length;
+	}
+
+	static thread_local std::vector<uint8_t> decoded;
+	if (!inflater->decompress(compressed.data(), compressedLength, decoded) || decoded.size() != length || !std::equal(decoded.begin(), decoded.end(), msg.getOutputBuffer())) {
+		console::reportWarning(__FUNCTION__, fmt::format("Compressed packet of {:d} bytes does not decode to the original.", length));
+	}
+	return compressedLength;
+}
+
 OutputMessage_ptr Protocol::getOutputBuffer(int32_t size)
 {
 	//dispatcher thread
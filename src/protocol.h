@@ -4,6 +4,7 @@
 #ifndef FS_PROTOCOL_H
 #define FS_PROTOCOL_H
 
+#include "compression.h"
 #include "connection.h"
 #include "xtea.h"
 
@@ -25,7 +26,12 @@ class Protocol : public std::enable_shared_from_this<Protocol>
 		virtual void sendLoginChallenge() {}
 
 		bool isConnectionExpired() const {
-			return connection.expired();
+			return !headless && connection.expired();
+		}
+
+		// replayed sessions run without a connection
+		void setHeadless() {
+			headless = true;
 		}
 
 		Connection_ptr getConnection() const {
@@ -34,6 +40,10 @@ class Protocol : public std::enable_shared_from_this<Protocol>
 
 		uint32_t getIP() const;
 
+		uint64_t getSentBytes() const {
+			return sentBytes.load(std::memory_order_relaxed);
+		}
+
 		//Use this function for autosend messages only
 		OutputMessage_ptr getOutputBuffer(int32_t size);
 
@@ -41,11 +51,7 @@ class Protocol : public std::enable_shared_from_this<Protocol>
 			return outputBuffer;
 		}
 
-		void send(OutputMessage_ptr msg) const {
-			if (auto connection = getConnection()) {
-				connection->send(msg);
-			}
-		}
+		void send(OutputMessage_ptr msg) const;
 
 	protected:
 		void disconnect() const {
@@ -62,6 +68,8 @@ class Protocol : public std::enable_shared_from_this<Protocol>
 		void setChecksumMode(checksumMode_t newMode) {
 			checksumMode = newMode;
 		}
+		// compressed packets are flagged in the sequence number, so only sequence checksum clients can use it
+		void enableCompression();
 
 		static bool RSA_decrypt(NetworkMessage& msg);
 
@@ -74,7 +82,13 @@ class Protocol : public std::enable_shared_from_this<Protocol>
 	private:
 		friend class Connection;
 
+		bool compress(OutputMessage& msg);
+		// compressed size of a message sent by a replayed session, checked by decoding it again
+		size_t getHeadlessLength(OutputMessage& msg) const;
+
 		OutputMessage_ptr outputBuffer;
+		std::unique_ptr<PacketDeflater> deflater;
+		std::unique_ptr<PacketInflater> inflater;
 
 		const ConnectionWeak_ptr connection;
 		xtea::round_keys key;
@@ -82,6 +96,8 @@ class Protocol : public std::enable_shared_from_this<Protocol>
 		bool encryptionEnabled = false;
 		checksumMode_t checksumMode = CHECKSUM_ADLER;
 		bool rawMessages = false;
+		bool headless = false;
+		std::atomic<uint64_t> sentBytes {0};
 };
 
 #endif
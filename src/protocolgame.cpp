@@ -14,12 +14,14 @@
 #include "events.h"
 #include "game.h"
 #include "inbox.h"
+#include "databasetasks.h"
 #include "iologindata.h"
 #include "iomarket.h"
 #include "monster.h"
 #include "npc.h"
 #include "outfit.h"
 #include "outputmessage.h"
+#include "packetrecord.h"
 #include "player.h"
 #include "podium.h"
 #include "scheduler.h"
@@ -33,6 +35,13 @@ extern Events* g_events;
 
 namespace {
 
+constexpr int16_t NO_INPUT = -1;
+
+//opcode being parsed on this thread, game tasks added meanwhile go through the player's input queue
+thread_local int16_t inputOpcode = NO_INPUT;
+//tells apart actions of the same kind that must not replace each other
+thread_local uint64_t inputKey = 0;
+
 std::deque<std::pair<int64_t, uint32_t>> waitList; // (timeout, player guid)
 auto priorityEnd = waitList.end();
 
@@ -123,6 +132,10 @@ void ProtocolGame::release()
 		player = nullptr;
 	}
 
+	if (uint32_t session = recordSession.exchange(0, std::memory_order_relaxed)) {
+		PacketRecorder::getInstance().recordClose(session);
+	}
+
 	OutputMessagePool::getInstance().removeProtocolFromAutosend(shared_from_this());
 	Protocol::release();
 }
@@ -201,51 +214,19 @@ void ProtocolGame::login(const std::string& name, uint32_t accountId, OperatingS
 			return;
 		}
 
-		if (!IOLoginData::loadPlayerById(player, player->getGUID())) {
-			disconnectClient("Your character could not be loaded.");
-			return;
-		}
-
-		player->setOperatingSystem(operatingSystem);
-
-		if (!g_game.placeCreature(player, player->getLoginPosition())) {
-			if (!g_game.placeCreature(player, player->getTemplePosition(), false, true)) {
-				disconnectClient("Temple position is wrong. Contact the administrator.");
-				return;
-			}
-		}
-
-		if (operatingSystem >= CLIENTOS_OTCLIENT_LINUX) {
-			player->registerCreatureEvent("ExtendedOpcode");
-		}
-
-		// initialize account currencies
-		addGameTask(([=, playerGUID = player->getGUID()]() { g_game.playerRegisterCurrencies(playerGUID); }));
-
-		player->lastIP = player->getIP();
-		player->lastLoginSaved = std::max<time_t>(time(nullptr), player->lastLoginSaved + 1);
-		acceptPackets = true;
-
-		lastName = name;
-		lastAccountId = accountId;
-		lastOperatingSystem = operatingSystem;
-
-		// send blessings
-		sendBlessings();
-
-		// restore player channels
-		player->restoreChannelIDs();
+		//the character rows are fetched on the database thread, only building the player from them happens here
+		auto loadData = std::make_shared<PlayerLoadData>();
+		bool queued = g_databaseTasks.addJob([thisPtr = getThis(), guid = player->getGUID(), name, accountId, operatingSystem, loadData](Database& db) {
+			bool fetched = IOLoginData::fetchPlayerById(db, guid, *loadData);
+			g_dispatcher.addTask(createTask(([thisPtr, name, accountId, operatingSystem, loadData, fetched]() {
+				thisPtr->finishLogin(name, accountId, operatingSystem, fetched ? loadData.get() : nullptr);
+			})));
+		}, player->getGUID());
 
-		// restore player party
-		if (lastPartyId != 0) {
-			addGameTask(([=, playerID = player->getID(), partyID = lastPartyId]() { g_game.restorePlayerParty(playerID, partyID); }));
+		if (!queued) {
+			disconnectClient("Your character could not be loaded.");
 		}
-
-#ifdef DEBUG_DISCONNECT
-		console::print(CONSOLEMESSAGE_TYPE_INFO, "[DEBUG] Connecting (code 36)");
-#endif
-
-		addGameTask(([=, playerID = player->getID()]() { g_game.playerConnect(playerID, isLogin); }));
+		return;
 	} else {
 		if (eventConnect != 0 || !g_config.getBoolean(ConfigManager::REPLACE_KICK_ON_LOGIN)) {
 			//Already trying to connect
@@ -284,6 +265,74 @@ void ProtocolGame::login(const std::string& name, uint32_t accountId, OperatingS
 	OutputMessagePool::getInstance().addProtocolToAutosend(shared_from_this());
 }
 
+void ProtocolGame::finishLogin(const std::string& name, uint32_t accountId, OperatingSystem_t operatingSystem, const PlayerLoadData* loadData)
+{
+	//dispatcher thread
+	if (!player || isConnectionExpired()) {
+		//the client went away while the character was being fetched
+		return;
+	}
+
+	//someone else may have entered the world while the rows were fetched
+	if (!g_config.getBoolean(ConfigManager::ALLOW_CLONES) && g_game.getPlayerByName(name)) {
+		disconnectClient("You are already logged in.");
+		return;
+	}
+
+	if (g_config.getBoolean(ConfigManager::ONE_PLAYER_ON_ACCOUNT) && player->getAccountType() < ACCOUNT_TYPE_GAMEMASTER && g_game.getPlayerByAccount(player->getAccount())) {
+		disconnectClient("You may only login with one character\nof your account at the same time.");
+		return;
+	}
+
+	if (!loadData || !IOLoginData::loadPlayer(player, *loadData)) {
+		disconnectClient("Your character could not be loaded.");
+		return;
+	}
+
+	player->setOperatingSystem(operatingSystem);
+
+	if (!g_game.placeCreature(player, player->getLoginPosition())) {
+		if (!g_game.placeCreature(player, player->getTemplePosition(), false, true)) {
+			disconnectClient("Temple position is wrong. Contact the administrator.");
+			return;
+		}
+	}
+
+	if (operatingSystem >= CLIENTOS_OTCLIENT_LINUX) {
+		player->registerCreatureEvent("ExtendedOpcode");
+	}
+
+	// initialize account currencies
+	addGameTask(([=, playerGUID = player->getGUID()]() { g_game.playerRegisterCurrencies(playerGUID); }));
+
+	player->lastIP = player->getIP();
+	player->lastLoginSaved = std::max<time_t>(time(nullptr), player->lastLoginSaved + 1);
+	acceptPackets = true;
+
+	lastName = name;
+	lastAccountId = accountId;
+	lastOperatingSystem = operatingSystem;
+
+	// send blessings
+	sendBlessings();
+
+	// restore player channels
+	player->restoreChannelIDs();
+
+	// restore player party
+	if (lastPartyId != 0) {
+		addGameTask(([=, playerID = player->getID(), partyID = lastPartyId]() { g_game.restorePlayerParty(playerID, partyID); }));
+	}
+
+#ifdef DEBUG_DISCONNECT
+	console::print(CONSOLEMESSAGE_TYPE_INFO, "[DEBUG] Connecting (code 36)");
+#endif
+
+	addGameTask(([=, playerID = player->getID()]() { g_game.playerConnect(playerID, true); }));
+
+	OutputMessagePool::getInstance().addProtocolToAutosend(shared_from_this());
+}
+
 
 void ProtocolGame::sendRelogCancel(const std::string& msg, bool isRelog)
 {
@@ -686,6 +735,7 @@ void ProtocolGame::onRecvFirstMessage(NetworkMessage& msg)
 	// Change packet verifying mode for QT clients
 	if (version >= 1111 && operatingSystem >= CLIENTOS_QT_LINUX && operatingSystem < CLIENTOS_OTCLIENT_LINUX) {
 		setChecksumMode(CHECKSUM_SEQUENCE);
+		enableCompression();
 	}
 	
 	// Web login skips the character list request so we need to check the client version again
@@ -777,6 +827,10 @@ void ProtocolGame::onRecvFirstMessage(NetworkMessage& msg)
 		return;
 	}
 
+	if (PacketRecorder::getInstance().isRecording()) {
+		recordSession = PacketRecorder::getInstance().recordLogin(characterName, accountId, operatingSystem, version);
+	}
+
 	addGameTask(([=, thisPtr = getThis(), characterName = std::move(characterName)]() { thisPtr->login(characterName, accountId, operatingSystem); }));
 }
 
@@ -1068,8 +1122,24 @@ void ProtocolGame::writeToOutputBuffer(const NetworkMessage& msg)
 		StoreSuccess = 0xFE
 */
 
+void ProtocolGame::queueGameTask(Task* task)
+{
+	if (inputOpcode == NO_INPUT || !g_config.getBoolean(ConfigManager::INPUT_QUEUE)) {
+		g_dispatcher.addTask(task);
+		return;
+	}
+
+	if (inputQueue.push(static_cast<uint8_t>(inputOpcode), inputKey, task)) {
+		g_dispatcher.addTask(createTask([thisPtr = getThis()]() { thisPtr->inputQueue.drain(); }));
+	}
+}
+
 void ProtocolGame::parsePacket(NetworkMessage& msg)
 {
+	if (uint32_t session = recordSession.load(std::memory_order_relaxed)) {
+		PacketRecorder::getInstance().recordPacket(session, msg);
+	}
+
 	if (!acceptPackets || g_game.getGameState() == GAME_STATE_SHUTDOWN || msg.getLength() == 0) {
 #ifdef DEBUG_DISCONNECT
 		if (!acceptPackets) {
@@ -1123,6 +1193,9 @@ void ProtocolGame::parsePacket(NetworkMessage& msg)
 		return;
 	}
 
+	inputOpcode = recvbyte;
+	inputKey = 0;
+
 	// cases commented as "(scripted)" are being handled by lua scripts
 	switch (recvbyte) {
 		// 0x00-0x09 (0-9) - empty
@@ -1275,7 +1348,7 @@ void ProtocolGame::parsePacket(NetworkMessage& msg)
 		case 0xED: /* request resource balance (handled server side) */ break;
 		case 0xEE: addGameTask([playerID = player->getID()]() { g_game.playerSay(playerID, 0, TALKTYPE_SAY, "", "hi"); }); break;
 		//case 0xEF: break; // request store coins transfer
-		case 0xF0: g_dispatcher.addTask(createTask((DISPATCHER_TASK_EXPIRATION, ([playerID = player->getID()]() { g_game.playerShowQuestLog(playerID); })))); break;
+		case 0xF0: addGameTaskTimed(DISPATCHER_TASK_EXPIRATION, ([playerID = player->getID()]() { g_game.playerShowQuestLog(playerID); })); break;
 		case 0xF1: parseQuestLine(msg); break;
 		case 0xF2: parseRuleViolationReport(msg); break;
 		case 0xF3: /* get object info (automatic request sent when item is on action bar) */ break;
@@ -1297,6 +1370,8 @@ void ProtocolGame::parsePacket(NetworkMessage& msg)
 			break;
 	}
 
+	inputOpcode = NO_INPUT;
+
 	if (msg.isOverrun()) {
 #ifdef DEV_MODE
 		console::print(CONSOLEMESSAGE_TYPE_WARNING, fmt::format("Failed to parse {:#x} (client packet too short), disconnected. Sender: {:s} ({:s})", recvbyte, (player && !player->isRemoved()) ? player->getName() : "(invalid object)", convertIPToString(getIP()).c_str()));
@@ -1664,9 +1739,9 @@ void ProtocolGame::parseSetOutfit(NetworkMessage& msg)
 		bool podiumVisible = msg.getByte() == 1;
 
 		//apply to podium
-		g_dispatcher.addTask(createTask((DISPATCHER_TASK_EXPIRATION, ([=, playerID = player->getID()]() {
+		addGameTaskTimed(DISPATCHER_TASK_EXPIRATION, ([=, playerID = player->getID()]() {
 			g_game.playerEditPodium(playerID, newOutfit, pos, stackpos, spriteId, podiumVisible, direction);
-		}))));
+		}));
 	}
 }
 
@@ -1675,13 +1750,13 @@ void ProtocolGame::parseEditPodiumRequest(NetworkMessage& msg)
 	Position pos = msg.getPosition();
 	uint16_t spriteId = msg.get<uint16_t>();
 	uint8_t stackpos = msg.getByte();
-	g_dispatcher.addTask(createTask((DISPATCHER_TASK_EXPIRATION, [=, playerID = player->getID()]() { g_game.playerRequestEditPodium(playerID, pos, stackpos, spriteId); })));
+	addGameTaskTimed(DISPATCHER_TASK_EXPIRATION, ([=, playerID = player->getID()]() { g_game.playerRequestEditPodium(playerID, pos, stackpos, spriteId); }));
 }
 
 void ProtocolGame::parseToggleMount(NetworkMessage& msg)
 {
 	bool mount = msg.getByte() != 0;
-	g_dispatcher.addTask(createTask(([=, playerID = player->getID()]() { g_game.playerToggleMount(playerID, mount); })));
+	addGameTask(([=, playerID = player->getID()]() { g_game.playerToggleMount(playerID, mount); }));
 }
 
 void ProtocolGame::parseUseItem(NetworkMessage& msg)
@@ -1690,7 +1765,7 @@ void ProtocolGame::parseUseItem(NetworkMessage& msg)
 	uint16_t spriteId = msg.get<uint16_t>();
 	uint8_t stackpos = msg.getByte();
 	uint8_t index = msg.getByte();
-	g_dispatcher.addTask(createTask((DISPATCHER_TASK_EXPIRATION, [=, playerID = player->getID()]() { g_game.playerUseItem(playerID, pos, stackpos, index, spriteId); })));
+	addGameTaskTimed(DISPATCHER_TASK_EXPIRATION, ([=, playerID = player->getID()]() { g_game.playerUseItem(playerID, pos, stackpos, index, spriteId); }));
 }
 
 void ProtocolGame::parseUseItemEx(NetworkMessage& msg)
@@ -1701,9 +1776,9 @@ void ProtocolGame::parseUseItemEx(NetworkMessage& msg)
 	Position toPos = msg.getPosition();
 	uint16_t toSpriteId = msg.get<uint16_t>();
 	uint8_t toStackPos = msg.getByte();
-	g_dispatcher.addTask(createTask((DISPATCHER_TASK_EXPIRATION, [=, playerID = player->getID()]() {
+	addGameTaskTimed(DISPATCHER_TASK_EXPIRATION, ([=, playerID = player->getID()]() {
 		g_game.playerUseItemEx(playerID, fromPos, fromStackPos, fromSpriteId, toPos, toStackPos, toSpriteId);
-	})));
+	}));
 }
 
 void ProtocolGame::parseUseWithCreature(NetworkMessage& msg)
@@ -1712,27 +1787,28 @@ void ProtocolGame::parseUseWithCreature(NetworkMessage& msg)
 	uint16_t spriteId = msg.get<uint16_t>();
 	uint8_t fromStackPos = msg.getByte();
 	uint32_t creatureId = msg.get<uint32_t>();
-	g_dispatcher.addTask(createTask((DISPATCHER_TASK_EXPIRATION, [=, playerID = player->getID()]() {
+	addGameTaskTimed(DISPATCHER_TASK_EXPIRATION, ([=, playerID = player->getID()]() {
 		g_game.playerUseWithCreature(playerID, fromPos, fromStackPos, creatureId, spriteId);
-	})));
+	}));
 }
 
 void ProtocolGame::parseCloseContainer(NetworkMessage& msg)
 {
 	uint8_t cid = msg.getByte();
-	g_dispatcher.addTask(createTask(([=, playerID = player->getID()]() { g_game.playerCloseContainer(playerID, cid); })));
+	addGameTask(([=, playerID = player->getID()]() { g_game.playerCloseContainer(playerID, cid); }));
 }
 
 void ProtocolGame::parseUpArrowContainer(NetworkMessage& msg)
 {
 	uint8_t cid = msg.getByte();
-	g_dispatcher.addTask(createTask(([=, playerID = player->getID()]() { g_game.playerMoveUpContainer(playerID, cid); })));
+	addGameTask(([=, playerID = player->getID()]() { g_game.playerMoveUpContainer(playerID, cid); }));
 }
 
 void ProtocolGame::parseUpdateContainer(NetworkMessage& msg)
 {
 	uint8_t cid = msg.getByte();
-	g_dispatcher.addTask(createTask(([=, playerID = player->getID()]() { g_game.playerUpdateContainer(playerID, cid); })));
+	inputKey = cid;
+	addGameTask(([=, playerID = player->getID()]() { g_game.playerUpdateContainer(playerID, cid); }));
 }
 
 void ProtocolGame::parseThrow(NetworkMessage& msg)
@@ -1744,9 +1820,9 @@ void ProtocolGame::parseThrow(NetworkMessage& msg)
 	uint8_t count = msg.getByte();
 
 	if (toPos != fromPos) {
-		g_dispatcher.addTask(createTask(([=, playerID = player->getID()]() {
+		addGameTask(([=, playerID = player->getID()]() {
 			g_game.playerMoveThing(playerID, fromPos, spriteId, fromStackpos, toPos, count);
-		})));
+		}));
 	}
 }
 
@@ -1755,13 +1831,15 @@ void ProtocolGame::parseLookAt(NetworkMessage& msg)
 	Position pos = msg.getPosition();
 	msg.skipBytes(2); // spriteId
 	uint8_t stackpos = msg.getByte();
-	g_dispatcher.addTask(createTask((DISPATCHER_TASK_EXPIRATION, [=, playerID = player->getID()]() { g_game.playerLookAt(playerID, pos, stackpos); })));
+	inputKey = (static_cast<uint64_t>(pos.x) << 32) | (static_cast<uint64_t>(pos.y) << 16) | (static_cast<uint64_t>(pos.z) << 8) | stackpos;
+	addGameTaskTimed(DISPATCHER_TASK_EXPIRATION, ([=, playerID = player->getID()]() { g_game.playerLookAt(playerID, pos, stackpos); }));
 }
 
 void ProtocolGame::parseLookInBattleList(NetworkMessage& msg)
 {
 	uint32_t creatureID = msg.get<uint32_t>();
-	g_dispatcher.addTask(createTask((DISPATCHER_TASK_EXPIRATION, [=, playerID = player->getID()]() { g_game.playerLookInBattleList(playerID, creatureID); })));
+	inputKey = creatureID;
+	addGameTaskTimed(DISPATCHER_TASK_EXPIRATION, ([=, playerID = player->getID()]() { g_game.playerLookInBattleList(playerID, creatureID); }));
 }
 
 void ProtocolGame::parseSay(NetworkMessage& msg)
@@ -1795,9 +1873,9 @@ void ProtocolGame::parseSay(NetworkMessage& msg)
 		channelId = CHANNEL_GUILD;
 	}
 
-	g_dispatcher.addTask(createTask(([=, playerID = player->getID(), receiver = std::move(receiver), text = std::move(text)]() {
+	addGameTask(([=, playerID = player->getID(), receiver = std::move(receiver), text = std::move(text)]() {
 		g_game.playerSay(playerID, channelId, type, receiver, text);
-	})));
+	}));
 }
 
 void ProtocolGame::parseFightModes(NetworkMessage& msg)
@@ -1816,21 +1894,21 @@ void ProtocolGame::parseFightModes(NetworkMessage& msg)
 		fightMode = FIGHTMODE_DEFENSE;
 	}
 
-	g_dispatcher.addTask(createTask(([=, playerID = player->getID()]() { g_game.playerSetFightModes(playerID, fightMode, rawChaseMode != 0, rawSecureMode != 0); })));
+	addGameTask(([=, playerID = player->getID()]() { g_game.playerSetFightModes(playerID, fightMode, rawChaseMode != 0, rawSecureMode != 0); }));
 }
 
 void ProtocolGame::parseAttack(NetworkMessage& msg)
 {
 	uint32_t creatureID = msg.get<uint32_t>();
 	// msg.get<uint32_t>(); creatureID (same as above)
-	g_dispatcher.addTask(createTask(([=, playerID = player->getID()]() { g_game.playerSetAttackedCreature(playerID, creatureID); })));
+	addGameTask(([=, playerID = player->getID()]() { g_game.playerSetAttackedCreature(playerID, creatureID); }));
 }
 
 void ProtocolGame::parseFollow(NetworkMessage& msg)
 {
 	uint32_t creatureID = msg.get<uint32_t>();
 	// msg.get<uint32_t>(); creatureID (same as above)
-	g_dispatcher.addTask(createTask(([=, playerID = player->getID()]() { g_game.playerFollowCreature(playerID, creatureID); })));
+	addGameTask(([=, playerID = player->getID()]() { g_game.playerFollowCreature(playerID, creatureID); }));
 }
 
 void ProtocolGame::parseEquipObject(NetworkMessage& msg)
@@ -1847,7 +1925,7 @@ void ProtocolGame::parseEquipObject(NetworkMessage& msg)
 		tier = msg.getByte();
 	}
 
-	g_dispatcher.addTask(createTask((DISPATCHER_TASK_EXPIRATION, [=, playerID = player->getID(), isTiered = it.classification > 0]() { g_game.playerEquipItem(playerID, spriteId, isTiered, tier); })));
+	addGameTaskTimed(DISPATCHER_TASK_EXPIRATION, ([=, playerID = player->getID(), isTiered = it.classification > 0]() { g_game.playerEquipItem(playerID, spriteId, isTiered, tier); }));
 }
 
 void ProtocolGame::parseTextWindow(NetworkMessage& msg)
@@ -1870,7 +1948,7 @@ void ProtocolGame::parseWrapItem(NetworkMessage& msg)
 	Position pos = msg.getPosition();
 	uint16_t spriteId = msg.get<uint16_t>();
 	uint8_t stackpos = msg.getByte();
-	g_dispatcher.addTask(createTask((DISPATCHER_TASK_EXPIRATION, ([=, playerID = player->getID()]() { g_game.playerWrapItem(playerID, pos, stackpos, spriteId); }))));
+	addGameTaskTimed(DISPATCHER_TASK_EXPIRATION, ([=, playerID = player->getID()]() { g_game.playerWrapItem(playerID, pos, stackpos, spriteId); }));
 }
 
 void ProtocolGame::parseQuickLoot(NetworkMessage& msg)
@@ -1879,7 +1957,7 @@ void ProtocolGame::parseQuickLoot(NetworkMessage& msg)
 	uint8_t stackpos = msg.getByte();
 	uint16_t spriteId = msg.get<uint16_t>();
 
-	g_dispatcher.addTask(createTask((DISPATCHER_TASK_EXPIRATION, ([=, playerID = player->getID()]() { g_game.playerQuickLoot(playerID, pos, stackpos, spriteId); }))));
+	addGameTaskTimed(DISPATCHER_TASK_EXPIRATION, ([=, playerID = player->getID()]() { g_game.playerQuickLoot(playerID, pos, stackpos, spriteId); }));
 }
 
 void ProtocolGame::parseSelectLootContainer(NetworkMessage& msg)
@@ -1912,7 +1990,7 @@ void ProtocolGame::parseQuickLootList(NetworkMessage& msg)
 		lootItems.push_back(msg.get<uint16_t>());
 	}
 
-	g_dispatcher.addTask(createTask((DISPATCHER_TASK_EXPIRATION, ([=, playerID = player->getID()]() { g_game.playerConfigureQuickLoot(playerID, lootItems, mode == 0x01); }))));
+	addGameTaskTimed(DISPATCHER_TASK_EXPIRATION, ([=, playerID = player->getID()]() { g_game.playerConfigureQuickLoot(playerID, lootItems, mode == 0x01); }));
 }
 
 void ProtocolGame::parseLookInShop(NetworkMessage& msg)
@@ -1920,7 +1998,7 @@ void ProtocolGame::parseLookInShop(NetworkMessage& msg)
 	uint16_t id = msg.get<uint16_t>();
 	uint8_t count = msg.getByte();
 
-	g_dispatcher.addTask(createTask((DISPATCHER_TASK_EXPIRATION, ([=, playerID = player->getID()]() { g_game.playerLookInShop(playerID, id, count); }))));
+	addGameTaskTimed(DISPATCHER_TASK_EXPIRATION, ([=, playerID = player->getID()]() { g_game.playerLookInShop(playerID, id, count); }));
 }
 
 void ProtocolGame::parsePlayerPurchase(NetworkMessage& msg)
@@ -1930,9 +2008,9 @@ void ProtocolGame::parsePlayerPurchase(NetworkMessage& msg)
 	uint16_t amount = msg.get<uint16_t>();
 	bool ignoreCap = msg.getByte() != 0;
 	bool inBackpacks = msg.getByte() != 0;
-	g_dispatcher.addTask(createTask((DISPATCHER_TASK_EXPIRATION, ([=, playerID = player->getID()]() {
+	addGameTaskTimed(DISPATCHER_TASK_EXPIRATION, ([=, playerID = player->getID()]() {
 		g_game.playerPurchaseItem(playerID, id, subType, amount, ignoreCap, inBackpacks);
-	}))));
+	}));
 }
 
 void ProtocolGame::parsePlayerSale(NetworkMessage& msg)
@@ -1941,7 +2019,7 @@ void ProtocolGame::parsePlayerSale(NetworkMessage& msg)
 	uint8_t subType = msg.getByte();
 	uint16_t amount = msg.get<uint16_t>();
 	bool ignoreEquipped = msg.getByte() != 0;
-	g_dispatcher.addTask(createTask((DISPATCHER_TASK_EXPIRATION, ([=, playerID = player->getID()]() { g_game.playerSellItem(playerID, id, subType, amount, ignoreEquipped); }))));
+	addGameTaskTimed(DISPATCHER_TASK_EXPIRATION, ([=, playerID = player->getID()]() { g_game.playerSellItem(playerID, id, subType, amount, ignoreEquipped); }));
 }
 
 void ProtocolGame::parseRequestTrade(NetworkMessage& msg)
@@ -1957,7 +2035,7 @@ void ProtocolGame::parseLookInTrade(NetworkMessage& msg)
 {
 	bool counterOffer = (msg.getByte() == 0x01);
 	uint8_t index = msg.getByte();
-	g_dispatcher.addTask(createTask((DISPATCHER_TASK_EXPIRATION, ([=, playerID = player->getID()]() { g_game.playerLookInTrade(playerID, counterOffer, index); }))));
+	addGameTaskTimed(DISPATCHER_TASK_EXPIRATION, ([=, playerID = player->getID()]() { g_game.playerLookInTrade(playerID, counterOffer, index); }));
 }
 
 void ProtocolGame::parseAddVip(NetworkMessage& msg)
@@ -1986,7 +2064,7 @@ void ProtocolGame::parseRotateItem(NetworkMessage& msg)
 	Position pos = msg.getPosition();
 	uint16_t spriteId = msg.get<uint16_t>();
 	uint8_t stackpos = msg.getByte();
-	g_dispatcher.addTask(createTask((DISPATCHER_TASK_EXPIRATION, ([=, playerID = player->getID()]() { g_game.playerRotateItem(playerID, pos, stackpos, spriteId); }))));
+	addGameTaskTimed(DISPATCHER_TASK_EXPIRATION, ([=, playerID = player->getID()]() { g_game.playerRotateItem(playerID, pos, stackpos, spriteId); }));
 }
 
 void ProtocolGame::parseRuleViolationReport(NetworkMessage& msg)
@@ -2319,14 +2397,14 @@ void ProtocolGame::parseInspectItem(NetworkMessage& msg)
 
 	switch (inspectionType) {
 		case INSPECTION_ITEM_NORMAL:
-			g_dispatcher.addTask(createTask((DISPATCHER_TASK_EXPIRATION, ([playerID = player->getID(), position = msg.getPosition()]() { g_game.playerInspectItem(playerID, position); }))));
+			addGameTaskTimed(DISPATCHER_TASK_EXPIRATION, ([playerID = player->getID(), position = msg.getPosition()]() { g_game.playerInspectItem(playerID, position); }));
 			break;
 		case INSPECTION_ITEM_PLAYERTRADE:
-			g_dispatcher.addTask(createTask((DISPATCHER_TASK_EXPIRATION, ([playerID = player->getID(), isInspectingPartnerOffer = msg.getByte() == 1, index = msg.getByte()]() { g_game.playerInspectTradeItem(playerID, isInspectingPartnerOffer, index); }))));
+			addGameTaskTimed(DISPATCHER_TASK_EXPIRATION, ([playerID = player->getID(), isInspectingPartnerOffer = msg.getByte() == 1, index = msg.getByte()]() { g_game.playerInspectTradeItem(playerID, isInspectingPartnerOffer, index); }));
 			break;
 		case INSPECTION_ITEM_NPCTRADE:
 		case INSPECTION_ITEM_CYCLOPEDIA:
-			g_dispatcher.addTask(createTask((DISPATCHER_TASK_EXPIRATION, ([playerID = player->getID(), spriteID = msg.get<uint16_t>(), isNpcTrade = inspectionType == INSPECTION_ITEM_NPCTRADE]() { g_game.playerInspectClientItem(playerID, spriteID, isNpcTrade); }))));
+			addGameTaskTimed(DISPATCHER_TASK_EXPIRATION, ([playerID = player->getID(), spriteID = msg.get<uint16_t>(), isNpcTrade = inspectionType == INSPECTION_ITEM_NPCTRADE]() { g_game.playerInspectClientItem(playerID, spriteID, isNpcTrade); }));
 			break;
 		default:
 			break;
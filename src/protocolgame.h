@@ -7,6 +7,7 @@
 #include "chat.h"
 #include "creature.h"
 #include "definitions.h"
+#include "inputqueue.h"
 #include "protocol.h"
 #include "tasks.h"
 
@@ -15,6 +16,7 @@ class Game;
 class NetworkMessage;
 class Player;
 class ProtocolGame;
+struct PlayerLoadData;
 class Quest;
 class Tile;
 class TrackedQuest;
@@ -73,6 +75,7 @@ class ProtocolGame final : public Protocol
 			return std::static_pointer_cast<ProtocolGame>(shared_from_this());
 		}
 		void connect(uint32_t playerId, OperatingSystem_t operatingSystem);
+		void finishLogin(const std::string& name, uint32_t accountId, OperatingSystem_t operatingSystem, const PlayerLoadData* loadData);
 		void disconnectClient(const std::string& message) const;
 		void writeToOutputBuffer(const NetworkMessage& msg);
 
@@ -365,18 +368,24 @@ class ProtocolGame final : public Protocol
 		void parseExtendedOpcode(NetworkMessage& msg);
 
 		friend class Player;
+		friend class PacketReplay;
 
 		// Helpers so we don't need to bind every time
 		template <typename Callable>
 		void addNewGameTask(Callable&& function, const std::string& function_str, const std::string& extra_info) {
-			g_dispatcher.addTask(createNewTask(std::forward<Callable>(function), function_str, extra_info));
+			queueGameTask(createNewTask(std::forward<Callable>(function), function_str, extra_info));
 		}
 
 		template <typename Callable>
 		void addNewGameTaskTimed(uint32_t delay, Callable&& function, const std::string& function_str, const std::string& extra_info) {
-			g_dispatcher.addTask(createNewTask(delay, std::forward<Callable>(function), function_str, extra_info));
+			queueGameTask(createNewTask(delay, std::forward<Callable>(function), function_str, extra_info));
 		}
 
+		// actions of a packet being parsed wait in the input queue, anything else goes straight to the dispatcher
+		void queueGameTask(Task* task);
+
+		InputQueue inputQueue;
+
 		std::unordered_map<uint32_t, int64_t> knownCreatureMap;
 		Player* player = nullptr;
 
@@ -388,6 +397,7 @@ class ProtocolGame final : public Protocol
 
 		bool debugAssertSent = false;
 		bool acceptPackets = false;
+		std::atomic<uint32_t> recordSession {0};
 
 		// player data which is still needed after player object destruction
 		std::vector<uint32_t> savedChannels;
@@ -0,0 +1,128 @@
+// Copyright 2022 The Forgotten Server Authors. All rights reserved.
+// Use of this source code is governed by the GPL-2.0 License that can be found in the LICENSE file.
+
+#include "otpch.h"
+
+#include "rng.h"
+
+namespace rng {
+
+namespace {
+
+std::atomic<bool> deterministic {false};
+std::atomic<uint64_t> baseSeed {0};
+std::atomic<uint64_t> threadCounter {0};
+
+uint64_t makeSeed()
+{
+	if (deterministic.load(std::memory_order_acquire)) {
+		//threads are numbered in the order they first draw
+		return baseSeed.load(std::memory_order_relaxed) + threadCounter.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	std::random_device rd;
+	return (static_cast<uint64_t>(rd()) << 32) | rd();
+}
+
+uint32_t next32(Engine& engine)
+{
+	return static_cast<uint32_t>(engine() >> 32);
+}
+
+uint32_t bounded(Engine& engine, uint32_t range)
+{
+	//Lemire's multiply-shift, the division only runs when the low half lands in the biased zone
+	uint64_t m = static_cast<uint64_t>(next32(engine)) * range;
+	uint32_t low = static_cast<uint32_t>(m);
+	if (low < range) {
+		const uint32_t threshold = -range % range;
+		while (low < threshold) {
+			m = static_cast<uint64_t>(next32(engine)) * range;
+			low = static_cast<uint32_t>(m);
+		}
+	}
+	return static_cast<uint32_t>(m >> 32);
+}
+
+int32_t uniform(Engine& engine, int32_t minNumber, uint32_t range)
+{
+	if (range == 0) {
+		//the full int32 range
+		return static_cast<int32_t>(next32(engine));
+	}
+	return static_cast<int32_t>(static_cast<uint32_t>(minNumber) + bounded(engine, range));
+}
+
+uint32_t getRange(int32_t minNumber, int32_t maxNumber)
+{
+	return static_cast<uint32_t>(maxNumber) - static_cast<uint32_t>(minNumber) + 1;
+}
+
+}
+
+Engine& getEngine()
+{
+	thread_local Engine engine(makeSeed());
+	return engine;
+}
+
+void seed(uint64_t seed)
+{
+	baseSeed.store(seed + 1, std::memory_order_relaxed);
+	threadCounter.store(0, std::memory_order_relaxed);
+	deterministic.store(true, std::memory_order_release);
+	getEngine().seed(seed);
+}
+
+uint32_t bounded(uint32_t range)
+{
+	return bounded(getEngine(), range);
+}
+
+int32_t uniform(int32_t minNumber, int32_t maxNumber)
+{
+	if (minNumber > maxNumber) {
+		std::swap(minNumber, maxNumber);
+	}
+	return uniform(getEngine(), minNumber, getRange(minNumber, maxNumber));
+}
+
+void uniform(int32_t minNumber, int32_t maxNumber, int32_t* out, size_t count)
+{
+	if (minNumber > maxNumber) {
+		std::swap(minNumber, maxNumber);
+	}
+
+	Engine& engine = getEngine();
+	const uint32_t range = getRange(minNumber, maxNumber);
+	for (size_t i = 0; i < count; ++i) {
+		out[i] = uniform(engine, minNumber, range);
+	}
+}
+
+double canonical()
+{
+	//the top 53 bits fill the mantissa exactly
+	return (getEngine()() >> 11) * 0x1.0p-53;
+}
+
+bool chance(double probability)
+{
+	return canonical() < probability;
+}
+
+float normal(float mean, float stddev)
+{
+	//Marsaglia's polar method; the second value is dropped so no state survives a reseed
+	Engine& engine = getEngine();
+	double u, v, s;
+	do {
+		u = (engine() >> 11) * 0x1.0p-52 - 1.0;
+		v = (engine() >> 11) * 0x1.0p-52 - 1.0;
+		s = u * u + v * v;
+	} while (s >= 1.0 || s == 0.0);
+
+	return static_cast<float>(mean + stddev * u * std::sqrt(-2.0 * std::log(s) / s));
+}
+
+} // namespace rng
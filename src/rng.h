@@ -0,0 +1,86 @@
+// Copyright 2022 The Forgotten Server Authors. All rights reserved.
+// Use of this source code is governed by the GPL-2.0 License that can be found in the LICENSE file.
+
+#ifndef FS_RNG_H
+#define FS_RNG_H
+
+namespace rng {
+
+/*
+ * xoshiro256**: 32 bytes of state and a handful of shifts per draw, fast
+ * enough to sit behind every combat and AI roll. Satisfies
+ * UniformRandomBitGenerator so it can be handed to std::shuffle.
+ */
+class Xoshiro256
+{
+	public:
+		using result_type = uint64_t;
+
+		explicit Xoshiro256(uint64_t seed = 0) {
+			this->seed(seed);
+		}
+
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+		// expands the seed with splitmix64, so nearby seeds give unrelated streams
+		void seed(uint64_t seed) {
+			for (uint64_t& word : state) {
+				seed += 0x9E3779B97F4A7C15;
+				uint64_t z = seed;
+				z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+				z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+				word = z ^ (z >> 31);
+			}
+		}
+
+		result_type operator()() {
+			const uint64_t result = rotl(state[1] * 5, 7) * 9;
+			const uint64_t t = state[1] << 17;
+
+			state[2] ^= state[0];
+			state[3] ^= state[1];
+			state[1] ^= state[2];
+			state[0] ^= state[3];
+			state[2] ^= t;
+			state[3] = rotl(state[3], 45);
+
+			return result;
+		}
+
+	private:
+		static constexpr uint64_t rotl(uint64_t x, int k) {
+			return (x << k) | (x >> (64 - k));
+		}
+
+		std::array<uint64_t, 4> state;
+};
+
+using Engine = Xoshiro256;
+
+// the calling thread's engine, every thread draws from its own
+Engine& getEngine();
+
+// deterministic mode: reseeds the calling thread and derives the seed of every
+// thread that draws for the first time afterwards from the same value
+void seed(uint64_t seed);
+
+// uniform in [0, range) without modulo bias, range must not be 0
+uint32_t bounded(uint32_t range);
+
+// uniform in [minNumber, maxNumber], both ends included
+int32_t uniform(int32_t minNumber, int32_t maxNumber);
+
+// fills out with count values uniform in [minNumber, maxNumber]
+void uniform(int32_t minNumber, int32_t maxNumber, int32_t* out, size_t count);
+
+// uniform in [0, 1)
+double canonical();
+
+bool chance(double probability);
+
+float normal(float mean, float stddev);
+
+} // namespace rng
+
+#endif
@@ -11,15 +11,18 @@ uint32_t Scheduler::addEvent(SchedulerTask* task)
 	if (task->getEventId() == 0) {
 		task->setEventId(++lastEventId);
 	}
+	scheduledEvents.increment();
 
 	boost::asio::post(io_context, [this, task]() {
 		// insert the event id in the list of active events
 		auto it = eventIdTimerMap.emplace(task->getEventId(), boost::asio::steady_timer{io_context});
 		auto& timer = it.first->second;
+		activeEvents.set(eventIdTimerMap.size());
 
 		timer.expires_from_now(std::chrono::milliseconds(task->getDelay()));
 		timer.async_wait([this, task](const boost::system::error_code& error) {
 			eventIdTimerMap.erase(task->getEventId());
+			activeEvents.set(eventIdTimerMap.size());
 
 			if (error == boost::asio::error::operation_aborted || getState() == THREAD_STATE_TERMINATED) {
 				// the timer has been manually canceled(timer->cancel()) or Scheduler::shutdown has been called
@@ -46,6 +46,9 @@ class Scheduler : public ThreadHolder<Scheduler>
 	private:
 		std::atomic<uint32_t> lastEventId{0};
 		std::unordered_map<uint32_t, boost::asio::steady_timer> eventIdTimerMap;
+
+		metrics::Counter& scheduledEvents = metrics::Registry::getInstance().counter("tfs_scheduler_events_total", "Events added to the scheduler");
+		metrics::Gauge& activeEvents = metrics::Registry::getInstance().gauge("tfs_scheduler_active_events", "Scheduler events waiting for their timer");
 		boost::asio::io_context io_context;
 		boost::asio::io_context::work work{io_context};
 };
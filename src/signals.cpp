@@ -11,6 +11,7 @@
 #include "events.h"
 #include "game.h"
 #include "globalevent.h"
+#include "luaprofiler.h"
 #include "monsters.h"
 #include "mounts.h"
 #include "movement.h"
@@ -54,6 +55,13 @@ void sigusr1Handler()
 	g_game.saveGameState();
 }
 
+void sigusr2Handler()
+{
+	//Dispatcher thread
+	console::print(CONSOLEMESSAGE_TYPE_INFO, "SIGUSR2 received, toggling the Lua profiler...");
+	g_luaProfiler.toggle(g_luaEnvironment.getLuaState());
+}
+
 void sighupHandler()
 {
 	//Dispatcher thread
@@ -162,6 +170,9 @@ void dispatchSignalHandler(int signal)
 		case SIGUSR1: //Saves game state
 			g_dispatcher.addTask(createTask(sigusr1Handler));
 			break;
+		case SIGUSR2: //Toggles the Lua profiler
+			g_dispatcher.addTask(createTask(sigusr2Handler));
+			break;
 #else
 		case SIGBREAK: //Shuts the server down
 			g_dispatcher.addTask(createTask(sigbreakHandler));
@@ -185,6 +196,7 @@ Signals::Signals(boost::asio::io_service& service): set(service)
 	set.add(SIGTERM);
 #ifndef _WIN32
 	set.add(SIGUSR1);
+	set.add(SIGUSR2);
 	set.add(SIGHUP);
 #else
 	// This must be a blocking call as Windows calls it in a new thread and terminates
@@ -12,7 +12,6 @@
 #include "npc.h"
 #include "pugicast.h"
 #include "scheduler.h"
-#include "spectators.h"
 
 extern ConfigManager g_config;
 extern Monsters g_monsters;
@@ -40,6 +39,26 @@ bool Spawns::loadFromXml(const std::string& filename)
 	this->filename = filename;
 	loaded = true;
 
+	//parse the monster and npc files referenced by the spawns up front, spread over all cores
+	std::vector<std::string> monsterNames;
+	std::vector<std::string> npcNames;
+	for (auto spawnNode : doc.child("spawns").children()) {
+		for (auto childNode : spawnNode.children()) {
+			if (caseInsensitiveEqual(childNode.name(), "monsters")) {
+				for (auto monsterNode : childNode.children()) {
+					monsterNames.emplace_back(monsterNode.attribute("name").as_string());
+				}
+			} else if (caseInsensitiveEqual(childNode.name(), "monster")) {
+				monsterNames.emplace_back(childNode.attribute("name").as_string());
+			} else if (caseInsensitiveEqual(childNode.name(), "npc")) {
+				npcNames.emplace_back(childNode.attribute("name").as_string());
+			}
+		}
+	}
+
+	g_monsters.stageMonsterTypes(monsterNames);
+	Npc::stageDocuments(npcNames);
+
 	for (auto spawnNode : doc.child("spawns").children()) {
 		Position centerPos(
 			pugi::cast<uint16_t>(spawnNode.attribute("centerx").value()),
@@ -225,6 +244,9 @@ bool Spawns::loadFromXml(const std::string& filename)
 			}
 		}
 	}
+
+	g_monsters.clearStagedDocuments();
+	Npc::clearStagedDocuments();
 	return true;
 }
 
@@ -254,9 +276,11 @@ void Spawns::startup()
 
 void Spawns::clear()
 {
-	for (Spawn& spawn : spawnList) {
-		spawn.stopEvent();
+	if (checkSpawnEvent != 0) {
+		g_scheduler.stopEvent(checkSpawnEvent);
+		checkSpawnEvent = 0;
 	}
+	spawnQueue = {};
 	spawnList.clear();
 
 	loaded = false;
@@ -274,13 +298,83 @@ bool Spawns::isInZone(const Position& centerPos, int32_t radius, const Position&
 			(pos.getY() >= centerPos.getY() - radius) && (pos.getY() <= centerPos.getY() + radius));
 }
 
+void Spawns::scheduleSpawn(Spawn* spawn, uint32_t spawnId, int64_t dueTime)
+{
+	spawnQueue.push({dueTime, spawn, spawnId});
+	scheduleCheck(dueTime);
+}
+
+void Spawns::scheduleCheck(int64_t dueTime)
+{
+	if (checkSpawnEvent != 0) {
+		if (dueTime >= nextCheck) {
+			return;
+		}
+		g_scheduler.stopEvent(checkSpawnEvent);
+	}
+
+	nextCheck = dueTime;
+	uint32_t delay = static_cast<uint32_t>(std::max<int64_t>(SCHEDULER_MINTICKS, dueTime - OTSYS_TIME()));
+	checkSpawnEvent = g_scheduler.addEvent(createSchedulerTask(delay, [this]() { checkSpawns(); }));
+}
+
+void Spawns::checkSpawns()
+{
+	checkSpawnEvent = 0;
+
+	AutoStat stat("Spawns::checkSpawns");
+
+	const int64_t now = OTSYS_TIME();
+	const uint32_t maxSpawns = static_cast<uint32_t>(g_config.getNumber(ConfigManager::RATE_SPAWN));
+
+	std::map<Spawn*, uint32_t> spawnCounts;
+	std::vector<SpawnCheck> deferred;
+	while (!spawnQueue.empty() && spawnQueue.top().dueTime <= now) {
+		SpawnCheck check = spawnQueue.top();
+		spawnQueue.pop();
+
+		uint32_t& spawnCount = spawnCounts[check.spawn];
+		if (spawnCount >= maxSpawns) {
+			check.dueTime = now + check.spawn->getInterval();
+			deferred.push_back(check);
+			continue;
+		}
+
+		if (check.spawn->checkSpawn(check.spawnId)) {
+			++spawnCount;
+		}
+	}
+
+	for (const SpawnCheck& check : deferred) {
+		spawnQueue.push(check);
+	}
+
+	if (!spawnQueue.empty()) {
+		scheduleCheck(spawnQueue.top().dueTime);
+	}
+}
+
 void Spawn::startSpawnCheck()
 {
-	if (checkSpawnEvent == 0) {
-		checkSpawnEvent = g_scheduler.addEvent(createSchedulerTask(getInterval(), [this]() { checkSpawn(); }));
+	cleanup();
+
+	const int64_t minDueTime = OTSYS_TIME() + getInterval();
+	for (auto& it : spawnMap) {
+		spawnBlock_t& sb = it.second;
+		if (sb.scheduled || spawnedMap.find(it.first) != spawnedMap.end()) {
+			continue;
+		}
+
+		scheduleBlock(it.first, sb, std::max<int64_t>(sb.lastSpawn + sb.interval, minDueTime));
 	}
 }
 
+void Spawn::scheduleBlock(uint32_t spawnId, spawnBlock_t& sb, int64_t dueTime)
+{
+	sb.scheduled = true;
+	g_game.map.spawns.scheduleSpawn(this, spawnId, dueTime);
+}
+
 Spawn::~Spawn()
 {
 	for (const auto& it : spawnedMap) {
@@ -292,14 +386,7 @@ Spawn::~Spawn()
 
 bool Spawn::findPlayer(const Position& pos)
 {
-	SpectatorVec spectators;
-	g_game.map.getSpectators(spectators, pos, false, true);
-	for (Creature* spectator : spectators) {
-		if (!spectator->getPlayer()->hasFlag(PlayerFlag_IgnoredByMonsters)) {
-			return true;
-		}
-	}
-	return false;
+	return g_game.map.isPlayerNearby(pos);
 }
 
 bool Spawn::isInSpawnZone(const Position& pos)
@@ -406,36 +493,33 @@ void Spawn::startup()
 	}
 }
 
-void Spawn::checkSpawn()
+bool Spawn::checkSpawn(uint32_t spawnId)
 {
-	checkSpawnEvent = 0;
-
-	cleanup();
-
-	uint32_t spawnCount = 0;
+	auto it = spawnMap.find(spawnId);
+	if (it == spawnMap.end()) {
+		return false;
+	}
 
-	for (auto& it : spawnMap) {
-		uint32_t spawnId = it.first;
-		if (spawnedMap.find(spawnId) != spawnedMap.end()) {
-			continue;
-		}
+	spawnBlock_t& sb = it->second;
+	sb.scheduled = false;
 
-		spawnBlock_t& sb = it.second;
-		if (OTSYS_TIME() >= sb.lastSpawn + sb.interval) {
-			if (!spawnMonster(spawnId, sb)) {
-				sb.lastSpawn = OTSYS_TIME();
-				continue;
-			}
+	cleanup();
+	if (spawnedMap.find(spawnId) != spawnedMap.end()) {
+		return false;
+	}
 
-			if (++spawnCount >= static_cast<uint32_t>(g_config.getNumber(ConfigManager::RATE_SPAWN))) {
-				break;
-			}
-		}
+	const int64_t now = OTSYS_TIME();
+	if (now < sb.lastSpawn + sb.interval) {
+		scheduleBlock(spawnId, sb, sb.lastSpawn + sb.interval);
+		return false;
 	}
 
-	if (spawnedMap.size() < spawnMap.size()) {
-		checkSpawnEvent = g_scheduler.addEvent(createSchedulerTask(getInterval(), [this]() { checkSpawn(); }));
+	if (!spawnMonster(spawnId, sb)) {
+		sb.lastSpawn = now;
+		scheduleBlock(spawnId, sb, now + sb.interval);
+		return false;
 	}
+	return true;
 }
 
 void Spawn::cleanup()
@@ -495,11 +579,3 @@ void Spawn::removeMonster(Monster* monster)
 		}
 	}
 }
-
-void Spawn::stopEvent()
-{
-	if (checkSpawnEvent != 0) {
-		g_scheduler.stopEvent(checkSpawnEvent);
-		checkSpawnEvent = 0;
-	}
-}
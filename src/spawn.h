@@ -9,6 +9,7 @@
 class Monster;
 class MonsterType;
 class Npc;
+class Spawn;
 
 struct spawnBlock_t {
 	Position pos;
@@ -17,6 +18,17 @@ struct spawnBlock_t {
 	uint32_t interval;
 	Direction direction;
 	uint8_t spawnTries = 0;
+	bool scheduled = false;
+};
+
+struct SpawnCheck {
+	int64_t dueTime;
+	Spawn* spawn;
+	uint32_t spawnId;
+
+	bool operator>(const SpawnCheck& other) const {
+		return dueTime > other.dueTime;
+	}
 };
 
 class Spawn
@@ -39,7 +51,6 @@ class Spawn
 		void startup();
 
 		void startSpawnCheck();
-		void stopEvent();
 
 		bool isInSpawnZone(const Position& pos);
 		void cleanup();
@@ -56,12 +67,14 @@ class Spawn
 		int32_t radius;
 
 		uint32_t interval = 60000;
-		uint32_t checkSpawnEvent = 0;
 
 		static bool findPlayer(const Position& pos);
 		bool spawnMonster(uint32_t spawnId, spawnBlock_t sb, bool startup = false);
 		bool spawnMonster(uint32_t spawnId, MonsterType* mType, const Position& pos, Direction dir, bool startup = false);
-		void checkSpawn();
+		void scheduleBlock(uint32_t spawnId, spawnBlock_t& sb, int64_t dueTime);
+		bool checkSpawn(uint32_t spawnId);
+
+		friend class Spawns;
 };
 
 class Spawns
@@ -86,7 +99,17 @@ class Spawns
 			return npcCount;
 		}
 
+		void scheduleSpawn(Spawn* spawn, uint32_t spawnId, int64_t dueTime);
+
 	private:
+		void scheduleCheck(int64_t dueTime);
+		void checkSpawns();
+
+		//respawns of all spawns ordered by due time, served by a single scheduler event
+		std::priority_queue<SpawnCheck, std::vector<SpawnCheck>, std::greater<SpawnCheck>> spawnQueue;
+		int64_t nextCheck = 0;
+		uint32_t checkSpawnEvent = 0;
+
 		std::forward_list<Npc*> npcList;
 		std::forward_list<Spawn> spawnList;
 		std::string filename;
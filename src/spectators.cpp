@@ -0,0 +1,87 @@
+// Copyright 2022 The Forgotten Server Authors. All rights reserved.
+// Use of this source code is governed by the GPL-2.0 License that can be found in the LICENSE file.
+
+#include "otpch.h"
+
+#include "spectators.h"
+
+#include "creature.h"
+
+namespace {
+
+constexpr size_t INITIAL_CAPACITY = 32;
+constexpr size_t ARENA_CAPACITY = 64;
+// buffers grown by an unusual crowd are not kept around
+constexpr size_t MAX_KEPT_CAPACITY = 4096;
+
+struct Arena {
+	~Arena();
+
+	std::vector<std::vector<Creature*>> buffers;
+};
+
+//vectors released during thread (or program) teardown are freed once the arena is gone
+thread_local bool arenaDestroyed = false;
+thread_local Arena arena;
+
+Arena::~Arena()
+{
+	arenaDestroyed = true;
+}
+
+//spectators are only gathered on the dispatcher thread
+uint32_t spectatorGeneration = 0;
+
+uint32_t nextGeneration()
+{
+	if (++spectatorGeneration == 0) {
+		//creatures that were never stamped hold zero, so it is never handed out
+		spectatorGeneration = 1;
+	}
+	return spectatorGeneration;
+}
+
+}
+
+SpectatorVec::Vec SpectatorVec::acquire()
+{
+	if (!arenaDestroyed && !arena.buffers.empty()) {
+		Vec buffer = std::move(arena.buffers.back());
+		arena.buffers.pop_back();
+		return buffer;
+	}
+
+	Vec buffer;
+	buffer.reserve(INITIAL_CAPACITY);
+	return buffer;
+}
+
+void SpectatorVec::release(Vec&& buffer)
+{
+	if (arenaDestroyed || buffer.capacity() == 0 || buffer.capacity() > MAX_KEPT_CAPACITY || arena.buffers.size() >= ARENA_CAPACITY) {
+		return;
+	}
+
+	buffer.clear();
+	arena.buffers.push_back(std::move(buffer));
+}
+
+void SpectatorVec::addSpectators(const SpectatorVec& spectators)
+{
+	if (vec.empty()) {
+		vec.assign(spectators.vec.begin(), spectators.vec.end());
+		return;
+	}
+
+	const uint32_t generation = nextGeneration();
+	for (Creature* spectator : vec) {
+		spectator->spectatorGeneration = generation;
+	}
+
+	for (Creature* spectator : spectators.vec) {
+		if (spectator->spectatorGeneration != generation) {
+			spectator->spectatorGeneration = generation;
+			vec.emplace_back(spectator);
+		}
+	}
+}
@@ -12,20 +12,30 @@ class SpectatorVec
 	using Iterator = Vec::iterator;
 	using ConstIterator = Vec::const_iterator;
 public:
-	SpectatorVec() {
-		vec.reserve(32);
+	// buffers are taken from (and given back to) a per-thread arena, so they keep their capacity between uses
+	SpectatorVec() : vec(acquire()) {}
+	SpectatorVec(const SpectatorVec& other) : vec(acquire()) {
+		vec.assign(other.vec.begin(), other.vec.end());
+	}
+	SpectatorVec(SpectatorVec&& other) noexcept : vec(std::move(other.vec)) {}
+	~SpectatorVec() {
+		release(std::move(vec));
 	}
 
-	void addSpectators(const SpectatorVec& spectators) {
-		for (Creature* spectator : spectators.vec) {
-			auto it = std::find(vec.begin(), vec.end(), spectator);
-			if (it != end()) {
-				continue;
-			}
-			vec.emplace_back(spectator);
+	SpectatorVec& operator=(const SpectatorVec& other) {
+		if (this != &other) {
+			vec.assign(other.vec.begin(), other.vec.end());
 		}
+		return *this;
+	}
+	SpectatorVec& operator=(SpectatorVec&& other) noexcept {
+		vec.swap(other.vec);
+		return *this;
 	}
 
+	// union in O(n + m): creatures already present are stamped with a fresh generation and skipped
+	void addSpectators(const SpectatorVec& spectators);
+
 	void erase(Creature* spectator) {
 		auto it = std::find(vec.begin(), vec.end(), spectator);
 		if (it == end()) {
@@ -44,6 +54,9 @@ public:
 	void emplace_back(Creature* c) { vec.emplace_back(c); }
 
 private:
+	static Vec acquire();
+	static void release(Vec&& buffer);
+
 	Vec vec;
 };
 
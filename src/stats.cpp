@@ -3,6 +3,9 @@
 
 #include "otpch.h"
 #include "stats.h"
+#include "compression.h"
+#include "connection.h"
+#include "objectpool.h"
 #include "tools.h"
 #include "tasks.h"
 #include <fstream>
@@ -74,6 +77,8 @@ void Stats::threadMain() {
 			writeStats("special.log", special.stats);
 			special.stats.clear();
 			special.lastDump = OTSYS_TIME();
+			writePoolStats("objectpool.log");
+			writeConnectionStats("connections.log");
 		}
 
 		if (last_iteration)
@@ -216,3 +221,45 @@ void Stats::writeStats(const std::string& file, const statsMap& stats, const std
 	out.flush();
 	out.close();
 }
+
+void Stats::writePoolStats(const std::string& file) {
+	std::ofstream out(std::string("data/logs/stats/") + file, std::ofstream::out | std::ofstream::app);
+	if (!out.is_open()) {
+		std::clog << "Can't open " << std::string("data/logs/stats/") + file << " (check if directory exists)" << std::endl;
+		return;
+	}
+	out << "[" << formatDate(time(NULL)) << "]\n";
+	out << std::setw(10) << "Block" << std::setw(12) << "Live" << std::setw(15) << "Allocations" << std::setw(15) << "From heap" << "\n";
+	for (const ObjectPool::ClassStats& stats : ObjectPool::getStats()) {
+		if (stats.allocations != 0) {
+			out << std::setw(10) << stats.blockSize << std::setw(12) << stats.live << std::setw(15) << stats.allocations << std::setw(15) << stats.heapAllocations << "\n";
+		}
+	}
+	out << std::setw(16) << "Type" << std::setw(12) << "Live" << std::setw(15) << "Allocations" << "\n";
+	for (const ObjectPool::TypeStats& stats : ObjectPool::getTypeStats()) {
+		out << std::setw(16) << stats.name << std::setw(12) << stats.live << std::setw(15) << stats.allocations << "\n";
+	}
+	out << "\n";
+	out.flush();
+	out.close();
+}
+
+void Stats::writeConnectionStats(const std::string& file) {
+	std::ofstream out(std::string("data/logs/stats/") + file, std::ofstream::out | std::ofstream::app);
+	if (!out.is_open()) {
+		std::clog << "Can't open " << std::string("data/logs/stats/") + file << " (check if directory exists)" << std::endl;
+		return;
+	}
+	const ConnectionManager::Stats stats = ConnectionManager::getInstance().getStats();
+	out << "[" << formatDate(time(NULL)) << "]\n";
+	out << "Active: " << stats.active << " Created: " << stats.created << " Released: " << stats.released << "\n";
+	out << "Lock contentions: " << stats.lockContentions << " Lock wait: " << (stats.lockWaitTime / 1000000.) << "ms\n";
+	const PacketDeflater::Stats compression = PacketDeflater::getStats();
+	if (compression.packets != 0) {
+		out << "Compressed packets: " << compression.packets << " Bytes: " << compression.inputBytes << " -> " << compression.outputBytes <<
+			" (" << (100. * compression.outputBytes / compression.inputBytes) << "%) Time: " << (compression.time / 1000000.) << "ms\n";
+	}
+	out << "\n";
+	out.flush();
+	out.close();
+}
@@ -75,6 +75,8 @@ private:
 	void parseSpecialQueue(std::forward_list <Stat*>& queue);
 	void writeSlowInfo(const std::string& file, uint64_t executionTime, const std::string& description, const std::string& extraDescription);
 	void writeStats(const std::string& file, const statsMap& stats, const std::string& extraInfo = "");
+	void writePoolStats(const std::string& file);
+	void writeConnectionStats(const std::string& file);
 
 	std::mutex statsLock;
 	struct {
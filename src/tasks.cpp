@@ -25,7 +25,9 @@ void Dispatcher::threadMain()
 	std::vector<Task*> tmpTaskList;
 	// NOTE: second argument defer_lock is to prevent from immediate locking
 	std::unique_lock<std::mutex> taskLockUnique(taskLock, std::defer_lock);
+#ifdef STATS_ENABLED
 	std::chrono::high_resolution_clock::time_point time_point;
+#endif
 
 	while (getState() != THREAD_STATE_TERMINATED) {
 		// check if there are tasks waiting
@@ -41,19 +43,23 @@ void Dispatcher::threadMain()
 #endif
 		}
 		tmpTaskList.swap(taskList);
+		queueSize->set(0);
 		taskLockUnique.unlock();
 
 		for (Task* task : tmpTaskList) {
-#ifdef STATS_ENABLED
-			time_point = std::chrono::high_resolution_clock::now();
-#endif
+			const auto start = std::chrono::steady_clock::now();
+			queueLatency->observe(std::chrono::duration_cast<std::chrono::nanoseconds>(start - task->queuedAt));
 			if (!task->hasExpired()) {
 				++dispatcherCycle;
 				// execute it
 				(*task)();
+			} else {
+				expiredTasks->increment();
 			}
+			const auto executionTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+			taskDuration->observe(executionTime);
 #ifdef STATS_ENABLED
-			task->executionTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - time_point).count();
+			task->executionTime = executionTime.count();
 			g_stats.addDispatcherTask(dispatcherId, task);
 #else
 			delete task;
@@ -71,7 +77,9 @@ void Dispatcher::addTask(Task* task)
 
 	if (getState() == THREAD_STATE_RUNNING) {
 		do_signal = taskList.empty();
+		task->queuedAt = std::chrono::steady_clock::now();
 		taskList.push_back(task);
+		queueSize->set(taskList.size());
 	} else {
 		delete task;
 	}
@@ -92,6 +100,7 @@ void Dispatcher::shutdown()
 	});
 
 	std::lock_guard<std::mutex> lockClass(taskLock);
+	task->queuedAt = std::chrono::steady_clock::now();
 	taskList.push_back(task);
 
 	taskSignal.notify_one();
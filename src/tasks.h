@@ -4,6 +4,7 @@
 #ifndef FS_TASKS_H
 #define FS_TASKS_H
 
+#include "metrics.h"
 #include "thread_holder_base.h"
 #include "stats.h"
 
@@ -38,6 +39,7 @@ class Task
 		const std::string description;
 		const std::string extraDescription;
 		uint64_t executionTime = 0;
+		std::chrono::steady_clock::time_point queuedAt;
 
 	protected:
 		std::chrono::system_clock::time_point expiration = SYSTEM_TIME_ZERO;
@@ -58,6 +60,13 @@ class Dispatcher : public ThreadHolder<Dispatcher> {
 			static int id = 0;
 			dispatcherId = id;
 			id += 1;
+
+			const std::string labels = fmt::format("dispatcher=\"{:d}\"", dispatcherId);
+			metrics::Registry& registry = metrics::Registry::getInstance();
+			taskDuration = &registry.histogram("tfs_dispatcher_task_duration_seconds", "Time spent running dispatcher tasks", labels);
+			queueSize = &registry.gauge("tfs_dispatcher_queue_size", "Tasks waiting for the dispatcher", labels);
+			queueLatency = &registry.histogram("tfs_dispatcher_queue_latency_seconds", "Time tasks wait in the dispatcher queue", labels);
+			expiredTasks = &registry.counter("tfs_dispatcher_expired_tasks_total", "Dispatcher tasks dropped because they expired in the queue", labels);
 		}
 
 		void addTask(Task* task);
@@ -68,6 +77,11 @@ class Dispatcher : public ThreadHolder<Dispatcher> {
 			return dispatcherCycle;
 		}
 
+		// for tasks that a dispatcher task runs itself and drops once they expired
+		void addExpiredTask() {
+			expiredTasks->increment();
+		}
+
 		void threadMain();
 
 	private:
@@ -77,6 +91,11 @@ class Dispatcher : public ThreadHolder<Dispatcher> {
 		std::vector<Task*> taskList;
 		uint64_t dispatcherCycle = 0;
 		int dispatcherId = 0;
+
+		metrics::Histogram* taskDuration;
+		metrics::Gauge* queueSize;
+		metrics::Histogram* queueLatency;
+		metrics::Counter* expiredTasks;
 };
 
 extern Dispatcher g_dispatcher;
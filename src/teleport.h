@@ -11,6 +11,13 @@ class Teleport final : public Item, public Cylinder
 	public:
 		explicit Teleport(uint16_t type) : Item(type) {};
 
+		static void* operator new(size_t size) {
+			return ObjectPool::allocate(size, POOLED_TELEPORT);
+		}
+		static void operator delete(void* p, size_t size) {
+			ObjectPool::deallocate(p, size, POOLED_TELEPORT);
+		}
+
 		Teleport* getTeleport() override {
 			return this;
 		}
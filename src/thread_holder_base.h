@@ -25,6 +25,10 @@ class ThreadHolder
 				thread.join();
 			}
 		}
+
+		bool isCurrentThread() const {
+			return thread.get_id() == std::this_thread::get_id();
+		}
 	protected:
 		void setState(ThreadState newState) {
 			threadState.store(newState, std::memory_order_relaxed);
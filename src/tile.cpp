@@ -311,7 +311,7 @@ Item* Tile::getItemByTopOrder(int32_t topOrder)
 	//4: creatures
 	if (TileItemVector* items = getItemList()) {
 		for (auto it = ItemVector::const_reverse_iterator(items->getEndTopItem()), end = ItemVector::const_reverse_iterator(items->getBeginTopItem()); it != end; ++it) {
-			if (Item::items[(*it)->getID()].alwaysOnTopOrder == topOrder) {
+			if (Item::items.getHotItemType((*it)->getID()).alwaysOnTopOrder == topOrder) {
 				return (*it);
 			}
 		}
@@ -506,7 +506,7 @@ ReturnValue Tile::queryAdd(int32_t, const Thing& thing, uint32_t, uint32_t flags
 				return RETURNVALUE_NOTPOSSIBLE;
 			}
 
-			const CreatureVector* creatures = getCreatures();
+			const CreatureVector* creatures = hasFlag(TILESTATE_CREATURES) ? getCreatures() : nullptr;
 			if (monster->canPushCreatures() && !monster->isSummon()) {
 				if (creatures) {
 					for (Creature* tileCreature : *creatures) {
@@ -543,6 +543,10 @@ ReturnValue Tile::queryAdd(int32_t, const Thing& thing, uint32_t, uint32_t flags
 				}
 			}
 
+			if (!hasFlag(TILESTATE_DAMAGINGFIELD)) {
+				return RETURNVALUE_NOERROR;
+			}
+
 			MagicField* field = getFieldItem();
 			if (!field || field->isBlocking() || field->getDamage() == 0) {
 				return RETURNVALUE_NOERROR;
@@ -567,7 +571,7 @@ ReturnValue Tile::queryAdd(int32_t, const Thing& thing, uint32_t, uint32_t flags
 			return RETURNVALUE_NOERROR;
 		}
 
-		const CreatureVector* creatures = getCreatures();
+		const CreatureVector* creatures = hasFlag(TILESTATE_CREATURES) ? getCreatures() : nullptr;
 		if (const Player* player = creature->getPlayer()) {
 			if (creatures && !creatures->empty() && !hasBitSet(FLAG_IGNOREBLOCKCREATURE, flags) && !player->isAccessPlayer()) {
 				for (const Creature* tileCreature : *creatures) {
@@ -613,23 +617,9 @@ ReturnValue Tile::queryAdd(int32_t, const Thing& thing, uint32_t, uint32_t flags
 			if (hasFlag(TILESTATE_BLOCKSOLID)) {
 				return RETURNVALUE_NOTENOUGHROOM;
 			}
-		} else {
-			//FLAG_IGNOREBLOCKITEM is set
-			if (ground) {
-				const ItemType& iiType = Item::items[ground->getID()];
-				if (iiType.blockSolid && (!iiType.moveable || ground->hasAttribute(ITEM_ATTRIBUTE_UNIQUEID))) {
-					return RETURNVALUE_NOTPOSSIBLE;
-				}
-			}
-
-			if (const auto items = getItemList()) {
-				for (const Item* item : *items) {
-					const ItemType& iiType = Item::items[item->getID()];
-					if (iiType.blockSolid && (!iiType.moveable || item->hasAttribute(ITEM_ATTRIBUTE_UNIQUEID))) {
-						return RETURNVALUE_NOTPOSSIBLE;
-					}
-				}
-			}
+		} else if (hasFlag(TILESTATE_IMMOVABLEBLOCKSOLID)) {
+			//FLAG_IGNOREBLOCKITEM is set, only items that cannot be pushed away block
+			return RETURNVALUE_NOTPOSSIBLE;
 		}
 	} else if (const Item* item = thing.getItem()) {
 		const TileItemVector* items = getItemList();
@@ -650,7 +640,7 @@ ReturnValue Tile::queryAdd(int32_t, const Thing& thing, uint32_t, uint32_t flags
 			return RETURNVALUE_NOTPOSSIBLE;
 		}
 
-		const CreatureVector* creatures = getCreatures();
+		const CreatureVector* creatures = hasFlag(TILESTATE_CREATURES) ? getCreatures() : nullptr;
 		if (creatures && !creatures->empty() && item->isBlocking() && !hasBitSet(FLAG_IGNOREBLOCKCREATURE, flags)) {
 			for (const Creature* tileCreature : *creatures) {
 				if (!tileCreature->isInGhostMode()) {
@@ -670,14 +660,14 @@ ReturnValue Tile::queryAdd(int32_t, const Thing& thing, uint32_t, uint32_t flags
 			}
 		} else {
 			if (ground) {
-				const ItemType& iiType = Item::items[ground->getID()];
-				if (iiType.blockSolid) {
-					if (!iiType.allowPickupable || item->isMagicField() || item->isBlocking()) {
+				const HotItemType& iiType = Item::items.getHotItemType(ground->getID());
+				if (iiType.hasFlag(HotItemType::BLOCK_SOLID)) {
+					if (!iiType.hasFlag(HotItemType::ALLOW_PICKUPABLE) || item->isMagicField() || item->isBlocking()) {
 						if (!item->isPickupable()) {
 							return RETURNVALUE_NOTENOUGHROOM;
 						}
 
-						if (!iiType.hasHeight || iiType.pickupable || iiType.isBed()) {
+						if (!iiType.hasFlag(HotItemType::HAS_HEIGHT) || iiType.hasFlag(HotItemType::PICKUPABLE) || iiType.hasFlag(HotItemType::BED)) {
 							return RETURNVALUE_NOTENOUGHROOM;
 						}
 					}
@@ -686,12 +676,12 @@ ReturnValue Tile::queryAdd(int32_t, const Thing& thing, uint32_t, uint32_t flags
 
 			if (items) {
 				for (const Item* tileItem : *items) {
-					const ItemType& iiType = Item::items[tileItem->getID()];
-					if (!iiType.blockSolid) {
+					const HotItemType& iiType = Item::items.getHotItemType(tileItem->getID());
+					if (!iiType.hasFlag(HotItemType::BLOCK_SOLID)) {
 						continue;
 					}
 
-					if (iiType.allowPickupable && !item->isMagicField() && !item->isBlocking()) {
+					if (iiType.hasFlag(HotItemType::ALLOW_PICKUPABLE) && !item->isMagicField() && !item->isBlocking()) {
 						continue;
 					}
 
@@ -699,7 +689,7 @@ ReturnValue Tile::queryAdd(int32_t, const Thing& thing, uint32_t, uint32_t flags
 						return RETURNVALUE_NOTENOUGHROOM;
 					}
 
-					if (!iiType.hasHeight || iiType.pickupable || iiType.isBed()) {
+					if (!iiType.hasFlag(HotItemType::HAS_HEIGHT) || iiType.hasFlag(HotItemType::PICKUPABLE) || iiType.hasFlag(HotItemType::BED)) {
 						return RETURNVALUE_NOTENOUGHROOM;
 					}
 				}
@@ -852,6 +842,7 @@ void Tile::addThing(int32_t, Thing* thing)
 		creature->setParent(this);
 		CreatureVector* creatures = makeCreatures();
 		creatures->insert(creatures->begin(), creature);
+		setFlag(TILESTATE_CREATURES);
 	} else {
 		Item* item = thing->getItem();
 		if (!item) {
@@ -904,7 +895,7 @@ void Tile::addThing(int32_t, Thing* thing)
 			if (items) {
 				for (auto it = items->getBeginTopItem(), end = items->getEndTopItem(); it != end; ++it) {
 					//Note: this is different from internalAddThing
-					if (itemType.alwaysOnTopOrder <= Item::items[(*it)->getID()].alwaysOnTopOrder) {
+					if (itemType.alwaysOnTopOrder <= Item::items.getHotItemType((*it)->getID()).alwaysOnTopOrder) {
 						items->insert(it, item);
 						isInserted = true;
 						break;
@@ -1059,6 +1050,9 @@ void Tile::removeThing(Thing* thing, uint32_t count)
 				}
 
 				creatures->erase(it);
+				if (creatures->empty()) {
+					resetFlag(TILESTATE_CREATURES);
+				}
 			}
 		}
 		return;
@@ -1438,6 +1432,7 @@ void Tile::internalAddThing(uint32_t, Thing* thing)
 
 		CreatureVector* creatures = makeCreatures();
 		creatures->insert(creatures->begin(), creature);
+		setFlag(TILESTATE_CREATURES);
 	} else {
 		Item* item = thing->getItem();
 		if (!item) {
@@ -1461,7 +1456,7 @@ void Tile::internalAddThing(uint32_t, Thing* thing)
 		if (itemType.alwaysOnTop) {
 			bool isInserted = false;
 			for (auto it = items->getBeginTopItem(), end = items->getEndTopItem(); it != end; ++it) {
-				if (Item::items[(*it)->getID()].alwaysOnTopOrder > itemType.alwaysOnTopOrder) {
+				if (Item::items.getHotItemType((*it)->getID()).alwaysOnTopOrder > itemType.alwaysOnTopOrder) {
 					items->insert(it, item);
 					isInserted = true;
 					break;
@@ -1483,7 +1478,7 @@ void Tile::internalAddThing(uint32_t, Thing* thing)
 void Tile::setTileFlags(const Item* item)
 {
 	if (!hasFlag(TILESTATE_FLOORCHANGE)) {
-		const ItemType& it = Item::items[item->getID()];
+		const HotItemType& it = Item::items.getHotItemType(item->getID());
 		if (it.floorChange != 0) {
 			setFlag(it.floorChange);
 		}
@@ -1509,8 +1504,11 @@ void Tile::setTileFlags(const Item* item)
 		setFlag(TILESTATE_TELEPORT);
 	}
 
-	if (item->getMagicField()) {
+	if (const MagicField* field = item->getMagicField()) {
 		setFlag(TILESTATE_MAGICFIELD);
+		if (!field->isBlocking() && field->getDamage() != 0) {
+			setFlag(TILESTATE_DAMAGINGFIELD);
+		}
 	}
 
 	if (item->getMailbox()) {
@@ -1541,8 +1539,7 @@ void Tile::setTileFlags(const Item* item)
 
 void Tile::resetTileFlags(const Item* item)
 {
-	const ItemType& it = Item::items[item->getID()];
-	if (it.floorChange != 0) {
+	if (Item::items.getHotItemType(item->getID()).floorChange != 0) {
 		resetFlag(TILESTATE_FLOORCHANGE);
 	}
 
@@ -1575,7 +1572,7 @@ void Tile::resetTileFlags(const Item* item)
 	}
 
 	if (item->getMagicField()) {
-		resetFlag(TILESTATE_MAGICFIELD);
+		resetFlag(TILESTATE_MAGICFIELD | TILESTATE_DAMAGINGFIELD);
 	}
 
 	if (item->getMailbox()) {
@@ -1605,6 +1602,53 @@ bool Tile::isMoveableBlocking() const
 	return !ground || hasFlag(TILESTATE_BLOCKSOLID);
 }
 
+bool Tile::verifyWalkFlags() const
+{
+	const CreatureVector* creatures = getCreatures();
+	if (hasFlag(TILESTATE_CREATURES) != (creatures && !creatures->empty())) {
+		return false;
+	}
+
+	bool immovableBlockSolid = ground && ground->hasProperty(CONST_PROP_IMMOVABLEBLOCKSOLID);
+	if (const TileItemVector* items = getItemList()) {
+		for (const Item* item : *items) {
+			if (item->hasProperty(CONST_PROP_IMMOVABLEBLOCKSOLID)) {
+				immovableBlockSolid = true;
+				break;
+			}
+		}
+	}
+
+	if (hasFlag(TILESTATE_IMMOVABLEBLOCKSOLID) != immovableBlockSolid) {
+		return false;
+	}
+
+	//queryAdd still checks the field itself, the flag only has to be set whenever the field does damage
+	const MagicField* field = getFieldItem();
+	return !field || field->isBlocking() || field->getDamage() == 0 || hasFlag(TILESTATE_DAMAGINGFIELD);
+}
+
+void Tile::refreshFieldFlags()
+{
+	resetFlag(TILESTATE_DAMAGINGFIELD);
+
+	const MagicField* field = ground ? ground->getMagicField() : nullptr;
+	if (field && !field->isBlocking() && field->getDamage() != 0) {
+		setFlag(TILESTATE_DAMAGINGFIELD);
+		return;
+	}
+
+	if (const TileItemVector* items = getItemList()) {
+		for (const Item* item : *items) {
+			field = item->getMagicField();
+			if (field && !field->isBlocking() && field->getDamage() != 0) {
+				setFlag(TILESTATE_DAMAGINGFIELD);
+				return;
+			}
+		}
+	}
+}
+
 Item* Tile::getUseItem(int32_t index) const
 {
 	const TileItemVector* items = getItemList();
@@ -46,6 +46,10 @@ enum tileflags_t : uint32_t {
 	TILESTATE_IMMOVABLENOFIELDBLOCKPATH = 1 << 21,
 	TILESTATE_NOFIELDBLOCKPATH = 1 << 22,
 	TILESTATE_SUPPORTS_HANGABLE = 1 << 23,
+	TILESTATE_CREATURES = 1 << 24, // at least one creature, ghosts included
+	// a magic field creatures walk into and take damage from, computed when the field is added
+	// and again after an items reload, which can change the damage or blocking of a field type
+	TILESTATE_DAMAGINGFIELD = 1 << 25,
 
 	TILESTATE_FLOORCHANGE = TILESTATE_FLOORCHANGE_DOWN | TILESTATE_FLOORCHANGE_NORTH | TILESTATE_FLOORCHANGE_SOUTH | TILESTATE_FLOORCHANGE_EAST | TILESTATE_FLOORCHANGE_WEST | TILESTATE_FLOORCHANGE_SOUTH_ALT | TILESTATE_FLOORCHANGE_EAST_ALT,
 };
@@ -170,6 +174,10 @@ class Tile : public Cylinder
 		Item* getTopTopItem() const;
 		Item* getTopDownItem() const;
 		bool isMoveableBlocking() const;
+		// recomputes the flags walk checks rely on from the items and creatures, false when they differ
+		bool verifyWalkFlags() const;
+		// sets the damaging field flag again from the field items, for when their types were reloaded
+		void refreshFieldFlags();
 		Thing* getTopVisibleThing(const Creature* creature);
 		Item* getItemByTopOrder(int32_t topOrder);
 
@@ -5,6 +5,7 @@
 
 #include "tools.h"
 
+#include "adler32.h"
 #include "configmanager.h"
 #include "definitions.h"
 
@@ -110,6 +111,40 @@ static void processSHA1MessageBlock(const uint8_t* messageBlock, uint32_t* H)
 	H[4] += E;
 }
 
+std::vector<XmlDocumentResult> loadXmlDocuments(const std::vector<std::string>& fileNames)
+{
+	std::vector<XmlDocumentResult> documents(fileNames.size());
+	if (fileNames.empty()) {
+		return documents;
+	}
+
+	std::atomic<size_t> nextIndex{0};
+	auto worker = [&]() {
+		size_t index;
+		while ((index = nextIndex++) < fileNames.size()) {
+			XmlDocumentResult& entry = documents[index];
+			entry.fileName = fileNames[index];
+			entry.document = std::make_shared<pugi::xml_document>();
+			entry.result = entry.document->load_file(entry.fileName.c_str());
+		}
+	};
+
+	size_t threadCount = std::min<size_t>(std::max<unsigned>(std::thread::hardware_concurrency(), 1), fileNames.size());
+	std::vector<std::thread> threads;
+	threads.reserve(threadCount - 1);
+	for (size_t i = 1; i < threadCount; ++i) {
+		threads.emplace_back(worker);
+	}
+
+	//the calling thread takes its share as well
+	worker();
+
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	return documents;
+}
+
 std::string transformToSHA1(const std::string& input)
 {
 	uint32_t H[] = {
@@ -299,27 +334,21 @@ IntegerVector vectorAtoi(const StringVector& stringVector)
 	return returnVector;
 }
 
-std::mt19937& getRandomGenerator()
+rng::Engine& getRandomGenerator()
 {
-	static std::random_device rd;
-	static std::mt19937 generator(rd());
-	return generator;
+	return rng::getEngine();
 }
 
 int32_t uniform_random(int32_t minNumber, int32_t maxNumber)
 {
-	static std::uniform_int_distribution<int32_t> uniformRand;
 	if (minNumber == maxNumber) {
 		return minNumber;
-	} else if (minNumber > maxNumber) {
-		std::swap(minNumber, maxNumber);
 	}
-	return uniformRand(getRandomGenerator(), std::uniform_int_distribution<int32_t>::param_type(minNumber, maxNumber));
+	return rng::uniform(minNumber, maxNumber);
 }
 
 int32_t normal_random(int32_t minNumber, int32_t maxNumber)
 {
-	static std::normal_distribution<float> normalRand(0.5f, 0.25f);
 	if (minNumber == maxNumber) {
 		return minNumber;
 	} else if (minNumber > maxNumber) {
@@ -328,7 +357,7 @@ int32_t normal_random(int32_t minNumber, int32_t maxNumber)
 
 	int32_t increment;
 	const int32_t diff = maxNumber - minNumber;
-	const float v = normalRand(getRandomGenerator());
+	const float v = rng::normal(0.5f, 0.25f);
 	if (v < 0.0) {
 		increment = diff / 2;
 	} else if (v > 1.0) {
@@ -341,8 +370,7 @@ int32_t normal_random(int32_t minNumber, int32_t maxNumber)
 
 bool boolean_random(double probability/* = 0.5*/)
 {
-	static std::bernoulli_distribution booleanRand;
-	return booleanRand(getRandomGenerator(), std::bernoulli_distribution::param_type(probability));
+	return rng::chance(probability);
 }
 
 void trimString(std::string& str)
@@ -954,24 +982,7 @@ uint32_t adlerChecksum(const uint8_t* data, size_t length)
 		return 0;
 	}
 
-	const uint16_t adler = 65521;
-
-	uint32_t a = 1, b = 0;
-
-	while (length > 0) {
-		size_t tmp = length > 5552 ? 5552 : length;
-		length -= tmp;
-
-		do {
-			a += *data++;
-			b += a;
-		} while (--tmp);
-
-		a %= adler;
-		b %= adler;
-	}
-
-	return (b << 16) | a;
+	return adler::checksum(data, length);
 }
 
 std::string ucfirst(std::string str)
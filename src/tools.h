@@ -7,9 +7,19 @@
 #include "const.h"
 #include "enums.h"
 #include "position.h"
+#include "rng.h"
 
 void printXMLError(const std::string& where, const std::string& fileName, const pugi::xml_parse_result& result);
 
+struct XmlDocumentResult {
+	std::string fileName;
+	pugi::xml_parse_result result;
+	std::shared_ptr<pugi::xml_document> document;
+};
+
+// parses the given files on worker threads, results are in the same order as fileNames
+std::vector<XmlDocumentResult> loadXmlDocuments(const std::vector<std::string>& fileNames);
+
 std::string transformToSHA1(const std::string& input);
 std::string generateToken(const std::string& key, uint32_t ticks);
 
@@ -35,7 +45,7 @@ constexpr bool hasBitSet(uint32_t flag, uint32_t flags) {
 	return (flags & flag) != 0;
 }
 
-std::mt19937& getRandomGenerator();
+rng::Engine& getRandomGenerator();
 int32_t uniform_random(int32_t minNumber, int32_t maxNumber);
 int32_t normal_random(int32_t minNumber, int32_t maxNumber);
 bool boolean_random(double probability = 0.5);